@@ -136,8 +136,8 @@ build_linux() {
         warning "  Arch:          sudo pacman -S libx11"
     fi
     
-    local LINUX_FLAGS="-std=c++17 -D__linux__ -I$SRC_DIR/include"
-    local LINUX_LIBS="-lX11"
+    local LINUX_FLAGS="-std=c++17 -D__linux__ -DFERN_X11_SHM -I$SRC_DIR/include"
+    local LINUX_LIBS="-lX11 -lXext"
     
     if [[ "$BUILD_TYPE" == "Debug" ]]; then
         LINUX_FLAGS="$LINUX_FLAGS -g -O0 -DDEBUG"
@@ -17,32 +17,17 @@ namespace EditorColors {
 }
 
 // Global state
-static std::string editorText = "Welcome to Fern Text Editor!\n\nStart typing here...";
-static std::shared_ptr<TextInputWidget> textInput;
+static const char* welcomeText = "Welcome to Fern Text Editor!\n\nStart typing here...";
+static std::shared_ptr<TextAreaWidget> textArea;
 static std::shared_ptr<TextWidget> statusText;
 static std::shared_ptr<CenterWidget> centerWidget;
-static int wordCount = 0;
-static int charCount = 0;
 
 void updateStatus() {
-    // Count words and characters
-    charCount = editorText.length();
-    wordCount = 0;
-    
-    bool inWord = false;
-    for (char c : editorText) {
-        if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {
-            if (!inWord) {
-                wordCount++;
-                inWord = true;
-            }
-        } else {
-            inWord = false;
-        }
-    }
-    
-    std::string status = "Characters: " + std::to_string(charCount) + 
-                        " | Words: " + std::to_string(wordCount);
+    // Everything here is O(1); the document is never copied
+    std::string status = "Ln " + std::to_string(textArea->getCursorLine() + 1) +
+                        ", Col " + std::to_string(textArea->getCursorColumn() + 1) +
+                        " | Lines: " + std::to_string(textArea->getLineCount()) +
+                        " | Bytes: " + std::to_string(textArea->getDocument().size());
     statusText->setText(status);
 }
 
@@ -50,37 +35,31 @@ void setupUI() {
     // Title
     auto titleText = Text(Point(0, 0), "Fern Text Editor", 3, EditorColors::Text);
     
-    // Text input area
+    // Multi-line text area
     TextInputStyle inputStyle;
     inputStyle.backgroundColor(EditorColors::TextArea)
              .textColor(EditorColors::Text)
              .borderColor(EditorColors::Selection)
              .focusBorderColor(0xFF4A90E2)  // Brighter blue for focus
+             .cursorColor(EditorColors::Text)
              .borderWidth(2)
              .fontSize(2)
              .padding(10);
     
-    textInput = TextInput(TextInputConfig(0, 0, 500, 40)  // Single line, reduced height
-        .placeholder("Start typing...")
+    textArea = TextArea(TextAreaConfig(0, 0, 500, 300)
         .style(inputStyle));
     
-    textInput->setText(editorText);
+    textArea->setText(welcomeText);
     
     // Set focus to enable typing
-    textInput->setFocus(true);
-    
-    // Connect to text change events
-    textInput->onTextChanged.connect([](const std::string& newText) {
-        editorText = newText;
-        updateStatus();
-    });
+    textArea->setFocus(true);
     
     // Connect to focus events to ensure input is active
-    textInput->onFocusChanged.connect([](bool focused) {
+    textArea->onFocusChanged.connect([](bool focused) {
         if (focused) {
-            std::cout << "Text input focused - ready for typing" << std::endl;
+            std::cout << "Text area focused - ready for typing" << std::endl;
         } else {
-            std::cout << "Text input lost focus" << std::endl;
+            std::cout << "Text area lost focus" << std::endl;
         }
     });
     
@@ -98,10 +77,8 @@ void setupUI() {
     
     auto clearBtn = Button(ButtonConfig(0, 0, 90, 35, "Clear").style(buttonStyle));
     clearBtn->onClick.connect([]() {
-        textInput->setText("");
-        editorText = "";
-        textInput->setFocus(true);  // Refocus after clearing
-        updateStatus();
+        textArea->clear();
+        textArea->setFocus(true);  // Refocus after clearing
     });
     
     auto saveBtn = Button(ButtonConfig(0, 0, 80, 35, "Save").style(buttonStyle));
@@ -112,11 +89,13 @@ void setupUI() {
     
     auto loadBtn = Button(ButtonConfig(0, 0, 80, 35, "Load").style(buttonStyle));
     loadBtn->onClick.connect([]() {
-        // Load sample text
-        editorText = "Sample text for editing";
-        textInput->setText(editorText);
-        textInput->setFocus(true);  // Refocus after loading
-        updateStatus();
+        // Load a long sample document; only the visible lines are laid out
+        std::string sample;
+        for (int i = 1; i <= 100000; i++) {
+            sample += "Line " + std::to_string(i) + ": sample text for editing\n";
+        }
+        textArea->setText(sample);
+        textArea->setFocus(true);  // Refocus after loading
     });
     
     // Button row
@@ -128,7 +107,7 @@ void setupUI() {
     std::vector<std::shared_ptr<Widget>> mainLayout = {
         titleText,
         SizedBox(0, 20),
-        textInput,
+        textArea,
         SizedBox(0, 15),
         statusText,
         SizedBox(0, 15),
@@ -153,6 +132,7 @@ void onWindowResize(int newWidth, int newHeight) {
 
 void draw() {
     Draw::fill(EditorColors::Background);
+    updateStatus();  // Follows cursor moves as well as edits
 }
 
 int main() {
@@ -451,6 +451,7 @@ compile_app() {
         # Compile with all C++ source files
         emcc "$source_file" $cpp_sources -o "$dist_dir/${output_base}.html" --shell-file template.html \
             $std_flag $include_path \
+            -msimd128 \
             -s WASM=1 \
             -s EXPORTED_RUNTIME_METHODS=['cwrap','HEAPU8'] \
             -s ALLOW_MEMORY_GROWTH=1 \
@@ -11,6 +11,7 @@
 
 #include "types.hpp"
 #include <cstdint>
+#include <vector>
 
 namespace Fern {
     /**
@@ -74,13 +75,13 @@ namespace Fern {
          * @brief Set a single pixel to the specified color
          * 
          * Sets the pixel at the given coordinates to the specified color.
-         * Coordinates are automatically bounds-checked for safety.
+         * Coordinates are automatically checked against the current clip.
          * 
          * @param x X-coordinate (0 to width-1)
          * @param y Y-coordinate (0 to height-1)  
          * @param color 32-bit RGBA color value
          * 
-         * @note Coordinates outside the canvas bounds are silently ignored
+         * @note Coordinates outside the clip rectangle are silently ignored
          */
         void setPixel(int x, int y, uint32_t color);
         
@@ -123,10 +124,117 @@ namespace Fern {
          */
         uint32_t* getBuffer() const { return buffer_; }
         
+        /**
+         * @brief Restrict drawing to a rectangle
+         * 
+         * Pushes a clip rectangle intersected with the current clip. Until the
+         * matching popClip(), every Draw and DrawText call only touches pixels
+         * inside it. Clips nest, so a child can never draw outside its parent.
+         * 
+         * @param x Left edge of the clip rectangle
+         * @param y Top edge of the clip rectangle
+         * @param width Width of the clip rectangle in pixels
+         * @param height Height of the clip rectangle in pixels
+         * 
+         * @example
+         * @code
+         * canvas.pushClip(50, 50, 100, 40);
+         * DrawText::drawText("Long label that is cut off", 50, 60, 2, Colors::White);
+         * canvas.popClip();
+         * @endcode
+         */
+        void pushClip(int x, int y, int width, int height);
+        
+        /**
+         * @brief Restore the clip that was active before the last pushClip()
+         * 
+         * @note Popping with no clip pushed is ignored
+         */
+        void popClip();
+        
+        /**
+         * @brief Get the current clip rectangle
+         * 
+         * @return const Rect& Area drawing is limited to, always inside the canvas
+         */
+        const Rect& getClip() const { return clip_; }
+        
+        /**
+         * @brief Check if a rectangle is completely outside the current clip
+         * 
+         * Widgets use this to skip rendering when nothing they draw could be seen.
+         */
+        bool isClippedOut(int x, int y, int width, int height) const {
+            return !Rect(x, y, width, height).intersects(clip_);
+        }
+        
+        /**
+         * @brief Mark a region of the canvas as changed
+         * 
+         * Adds the rectangle to the damage region that will be uploaded by the
+         * next present. The rectangle is clipped to the canvas and merged with
+         * any overlapping damage, so the region stays a short list of disjoint
+         * rectangles. All Draw and DrawText functions call this for you.
+         * 
+         * @param x Left edge of the changed area
+         * @param y Top edge of the changed area
+         * @param width Width of the changed area in pixels
+         * @param height Height of the changed area in pixels
+         * 
+         * @note Damage outside the current clip is ignored
+         * @note Call this yourself after writing to getBuffer() directly
+         */
+        void addDamage(int x, int y, int width, int height);
+        
+        /**
+         * @brief Mark the entire canvas as changed
+         */
+        void damageAll();
+        
+        /**
+         * @brief Get the rectangles changed since the last clearDamage()
+         * 
+         * @return const std::vector<Rect>& Disjoint damaged rectangles in canvas coordinates
+         */
+        const std::vector<Rect>& getDamage() const { return damage_; }
+        
+        /**
+         * @brief Check if anything was drawn since the last clearDamage()
+         */
+        bool hasDamage() const { return !damage_.empty(); }
+        
+        /**
+         * @brief Shrink the damage region to the pixels that differ from the last presented frame
+         * 
+         * Damage records every write, so a frame that starts with
+         * Draw::fill() damages the whole canvas even when only a cursor
+         * blinked. This compares each damaged row with a copy of the frame
+         * presented last and keeps only the changed ones, narrowed to the
+         * columns that changed. The render loop calls it before each
+         * present, at the cost of one extra frame of memory and a compare
+         * over the damaged area.
+         * 
+         * @note Until this has run once, the whole region is kept
+         */
+        void trimDamage();
+        
+        /**
+         * @brief Reset the damage region, typically right after presenting a frame
+         */
+        void clearDamage() { damage_.clear(); }
+        
     private:
+        /// Above this many rectangles the region collapses to its bounding box
+        static constexpr size_t kMaxDamageRects = 16;
+        
         uint32_t* buffer_;  ///< Pointer to the pixel buffer
         int width_;         ///< Canvas width in pixels  
         int height_;        ///< Canvas height in pixels
+        std::vector<Rect> damage_;  ///< Changed areas since the last present
+        std::vector<Rect> written_;          ///< Damage being trimmed, kept for its capacity
+        std::vector<uint32_t> presented_;    ///< Copy of the pixels as last presented
+        Rect clip_;                     ///< Current clip, intersected with the canvas
+        std::vector<Rect> clipStack_;   ///< Clips saved by pushClip()
     };
     
     /**
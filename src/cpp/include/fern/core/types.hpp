@@ -26,7 +26,137 @@ namespace Fern {
         Point() = default;
         Point(int x, int y) : x(x), y(y) {}
     };
-    
+
+    /**
+     * @brief Axis-aligned rectangle with integer coordinates
+     *
+     * Rect describes a region of the canvas by its top-left corner and size.
+     * It is used for damage tracking, clipping and widget bounds.
+     *
+     * @example Intersecting two rectangles:
+     * @code
+     * Rect a(0, 0, 100, 100);
+     * Rect b(50, 50, 100, 100);
+     * Rect overlap = a.intersected(b);  // (50, 50, 50, 50)
+     * @endcode
+     */
+    struct Rect {
+        int x = 0;       ///< Left edge
+        int y = 0;       ///< Top edge
+        int width = 0;   ///< Width in pixels
+        int height = 0;  ///< Height in pixels
+
+        Rect() = default;
+        Rect(int x, int y, int width, int height) : x(x), y(y), width(width), height(height) {}
+
+        int right() const { return x + width; }    ///< One past the right edge
+        int bottom() const { return y + height; }  ///< One past the bottom edge
+        bool isEmpty() const { return width <= 0 || height <= 0; }
+        int area() const { return isEmpty() ? 0 : width * height; }
+
+        /**
+         * @brief Check if another rectangle lies entirely inside this one
+         */
+        bool contains(const Rect& other) const {
+            return other.x >= x && other.y >= y &&
+                   other.right() <= right() && other.bottom() <= bottom();
+        }
+
+        /**
+         * @brief Check if two rectangles overlap
+         */
+        bool intersects(const Rect& other) const {
+            return other.x < right() && other.right() > x &&
+                   other.y < bottom() && other.bottom() > y;
+        }
+
+        /**
+         * @brief Get the overlapping part of two rectangles (empty if disjoint)
+         */
+        Rect intersected(const Rect& other) const {
+            int left = x > other.x ? x : other.x;
+            int top = y > other.y ? y : other.y;
+            int r = right() < other.right() ? right() : other.right();
+            int b = bottom() < other.bottom() ? bottom() : other.bottom();
+            if (r <= left || b <= top) return Rect();
+            return Rect(left, top, r - left, b - top);
+        }
+
+        /**
+         * @brief Get the smallest rectangle containing both rectangles
+         */
+        Rect united(const Rect& other) const {
+            if (isEmpty()) return other;
+            if (other.isEmpty()) return *this;
+            int left = x < other.x ? x : other.x;
+            int top = y < other.y ? y : other.y;
+            int r = right() > other.right() ? right() : other.right();
+            int b = bottom() > other.bottom() ? bottom() : other.bottom();
+            return Rect(left, top, r - left, b - top);
+        }
+    };
+
+    /**
+     * @brief Width and height in pixels, as returned by Widget::measure()
+     */
+    struct Size {
+        int width = 0;   ///< Width in pixels
+        int height = 0;  ///< Height in pixels
+
+        Size() = default;
+        Size(int width, int height) : width(width), height(height) {}
+
+        bool operator==(const Size& other) const { return width == other.width && height == other.height; }
+        bool operator!=(const Size& other) const { return !(*this == other); }
+    };
+
+    /**
+     * @brief Range of sizes a parent allows a child to take
+     *
+     * Passed down by layouts during the measure pass. A maximum of
+     * kUnbounded means the child may be as large as it likes along that
+     * axis, as in the main axis of a Column; equal minimum and maximum
+     * ("tight") force an exact size, as for Expanded children.
+     *
+     * @example
+     * @code
+     * Constraints loose(400, 300);                         // Up to 400x300
+     * Constraints tight = Constraints::tight(Size(100, 40));
+     * Size size = loose.constrain(Size(500, 20));         // 400x20
+     * @endcode
+     */
+    struct Constraints {
+        static constexpr int kUnbounded = 0x3FFFFFFF;  ///< Large, yet safe to add to
+
+        int minWidth = 0;
+        int minHeight = 0;
+        int maxWidth = kUnbounded;
+        int maxHeight = kUnbounded;
+
+        Constraints() = default;
+        Constraints(int maxWidth, int maxHeight) : maxWidth(maxWidth), maxHeight(maxHeight) {}
+        Constraints(int minWidth, int minHeight, int maxWidth, int maxHeight)
+            : minWidth(minWidth), minHeight(minHeight), maxWidth(maxWidth), maxHeight(maxHeight) {}
+
+        static Constraints tight(const Size& size) { return Constraints(size.width, size.height, size.width, size.height); }
+
+        bool hasBoundedWidth() const { return maxWidth < kUnbounded; }
+        bool hasBoundedHeight() const { return maxHeight < kUnbounded; }
+
+        /// Clamp @p size into the allowed range
+        Size constrain(const Size& size) const {
+            int width = size.width < minWidth ? minWidth : size.width;
+            int height = size.height < minHeight ? minHeight : size.height;
+            return Size(width > maxWidth ? maxWidth : width, height > maxHeight ? maxHeight : height);
+        }
+
+        bool operator==(const Constraints& other) const {
+            return minWidth == other.minWidth && minHeight == other.minHeight &&
+                   maxWidth == other.maxWidth && maxHeight == other.maxHeight;
+        }
+        bool operator!=(const Constraints& other) const { return !(*this == other); }
+    };
+
     /**
      * @brief Enumeration of keyboard key codes
      * 
@@ -92,6 +92,35 @@ namespace Fern
             );
         }
 
+        /**
+         * @brief Hold back layout of all widgets until endUpdate()
+         * 
+         * Rebuilding a screen adds many children, and each add() would
+         * normally lay out its layout again. Between beginUpdate() and
+         * endUpdate() changes are only recorded; endUpdate() lays out each
+         * changed top-level widget once. Updates nest, and LayoutBatch
+         * pairs the calls automatically.
+         * 
+         * @example Rebuilding a screen from live data:
+         * @code
+         * auto& manager = WidgetManager::getInstance();
+         * manager.beginUpdate();
+         * manager.clear();
+         * buildDashboard(stats);
+         * manager.endUpdate();
+         * @endcode
+         */
+        void beginUpdate() {
+            Widget::beginLayoutBatch();
+        }
+        
+        /**
+         * @brief Lay out once for all changes made since beginUpdate()
+         */
+        void endUpdate() {
+            Widget::endLayoutBatch();
+        }
+
         /**
          * @brief Update all widgets with input events
          * 
@@ -151,14 +180,15 @@ namespace Fern
          * @param newWidth New window width in pixels
          * @param newHeight New window height in pixels
          * 
-         * @note Only widgets that inherit from ResponsiveWidget will be notified
+         * @note Only widgets that inherit from ResponsiveWidget and return
+         *       themselves from Widget::asResponsive() will be notified
          */
         void onWindowResize(int newWidth, int newHeight) {
-            // Notify all widgets about the resize
+            // Notify all widgets about the resize, laying out once afterwards
+            LayoutBatch batch;
             for (auto& widget : widgets_) {
                 // Check if widget has responsive capabilities
-                auto responsiveWidget = dynamic_cast<ResponsiveWidget*>(widget.get());
-                if (responsiveWidget) {
+                if (auto responsiveWidget = widget->asResponsive()) {
                     responsiveWidget->onWindowResize(newWidth, newHeight);
                 }
             }
@@ -24,6 +24,7 @@
 #include "ui/widgets/line_widget.hpp"
 #include "ui/widgets/button_widget.hpp"
 #include "ui/widgets/text_input_widget.hpp"
+#include "ui/widgets/text_area_widget.hpp"
 #include "ui/widgets/slider_widget.hpp"
 #include "ui/widgets/radio_button_widget.hpp"
 #include "ui/widgets/dropdown_widget.hpp"
@@ -108,6 +109,58 @@ namespace Fern {
      */
     void startRenderLoop();
     
+    /**
+     * @brief When the render loop runs a frame
+     */
+    enum class RedrawMode {
+        Continuous,  ///< Run frames back to back (the default)
+        OnDemand     ///< Sleep until input, requestRedraw() or scheduleRedraw()
+    };
+    
+    /**
+     * @brief Choose when the desktop render loop runs frames
+     * 
+     * In OnDemand mode an idle window uses no CPU. A frame runs when window
+     * events arrive (followed by one more, so state changed by widget signals
+     * reaches the draw callback), when something calls requestRedraw(), or
+     * when a scheduleRedraw() timer is due. Widgets request a redraw when
+     * their setters change what they display. Code that animates must keep
+     * calling requestRedraw() or scheduleRedraw() from the draw callback.
+     * 
+     * Web builds always follow the browser's frame rate.
+     * 
+     * @param mode Continuous or OnDemand
+     * 
+     * @example
+     * @code
+     * Fern::setRedrawMode(Fern::RedrawMode::OnDemand);
+     * Fern::setDrawCallback([]() {
+     *     Draw::fill(Colors::Black);
+     *     drawClock();
+     *     Fern::scheduleRedraw(1000);  // Tick once a second
+     * });
+     * @endcode
+     */
+    void setRedrawMode(RedrawMode mode);
+    
+    /**
+     * @brief Ask for another frame as soon as possible
+     * 
+     * Safe to call from any thread, e.g. a thread that receives new data.
+     * Several requests before the next frame still run one frame.
+     */
+    void requestRedraw();
+    
+    /**
+     * @brief Ask for a frame after a delay
+     * 
+     * Only the earliest pending deadline is kept. Events or requestRedraw()
+     * may run frames sooner. Call from the thread running the render loop.
+     * 
+     * @param milliseconds Delay from now
+     */
+    void scheduleRedraw(int milliseconds);
+    
     /**
      * @brief Set the draw callback function
      * 
@@ -0,0 +1,35 @@
+#pragma once
+#include <cstdint>
+
+namespace Fern {
+
+    // Signed distance fields for size-independent glyphs. A field stores,
+    // per pixel, the distance to the nearest outline edge: kEdgeValue on
+    // the edge, higher inside, lower outside, at 255 / radius steps per
+    // pixel of distance.
+    namespace DistanceField {
+        constexpr float kEdgeValue = 191.25f;  // 3/4 of the range is outside
+
+        // Build a field from 8-bit anti-aliased coverage. Partial coverage
+        // places the edge inside the pixel, so the field is subpixel exact.
+        // field may be the coverage buffer itself.
+        void fromCoverage(const uint8_t* coverage, int width, int height,
+                          float radius, uint8_t* field);
+
+        // Field value to 0-255 coverage for a field drawn at `scale` times
+        // its own resolution: a linear ramp one destination pixel wide,
+        // centered on the edge
+        struct Ramp {
+            float slope;
+            float offset;
+            
+            Ramp(float radius, float scale)
+                : slope(scale * radius), offset(127.5f - kEdgeValue * scale * radius) {}
+            
+            uint8_t operator()(float value) const {
+                float alpha = value * slope + offset;
+                return static_cast<uint8_t>(alpha <= 0.0f ? 0.0f : (alpha >= 255.0f ? 255.0f : alpha + 0.5f));
+            }
+        };
+    }
+}
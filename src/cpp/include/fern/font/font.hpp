@@ -18,6 +18,8 @@ namespace Fern {
     public:
         // TTF font management
         static bool loadTTFFont(const std::string& name, const std::string& fontPath);
+        // Font bytes embedded in the program; not copied, must stay alive
+        static bool loadTTFFont(const std::string& name, const uint8_t* data, size_t size);
         static void setDefaultTTFFont(const std::string& name);
         static bool hasTTFFont();
         
@@ -0,0 +1,42 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Fern {
+
+    // One 8-bit coverage texture holding the bitmaps of many glyphs.
+    // Glyphs are packed left to right on shelves (rows of a fixed height);
+    // when every shelf is full the texture grows downwards.
+    class GlyphAtlas {
+    public:
+        explicit GlyphAtlas(int width);
+
+        // Reserve a width x height area and return its top-left corner.
+        // Fails only for glyphs wider than the atlas.
+        bool allocate(int width, int height, int& x, int& y);
+
+        // Row y of the texture. Pointers are invalidated when the atlas grows.
+        uint8_t* row(int y) { return pixels_.data() + static_cast<size_t>(y) * width_; }
+        const uint8_t* row(int y) const { return pixels_.data() + static_cast<size_t>(y) * width_; }
+
+        int getWidth() const { return width_; }
+        int getHeight() const { return height_; }
+        size_t getByteSize() const { return pixels_.size(); }
+
+        void clear();
+
+    private:
+        struct Shelf {
+            int y;
+            int height;
+            int used;   // Pixels taken from the left
+        };
+
+        std::vector<uint8_t> pixels_;
+        std::vector<Shelf> shelves_;
+        int width_;
+        int height_;
+        int nextShelfY_;
+    };
+}
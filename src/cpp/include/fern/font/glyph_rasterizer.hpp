@@ -0,0 +1,39 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+namespace Fern {
+
+    // Anti-aliased outline filler. Each edge adds the signed area it covers
+    // to an accumulation buffer; a running sum over the buffer then yields
+    // the 8-bit coverage of every pixel in one pass, with no edge lists or
+    // per-row sorting. Overlapping contours of the same winding saturate.
+    class GlyphRasterizer {
+    public:
+        // Start a width x height bitmap, keeping the buffer's allocation
+        void reset(int width, int height);
+
+        // Path in pixel coordinates, y pointing down. Contours are closed
+        // back to their moveTo point automatically.
+        void moveTo(float x, float y);
+        void lineTo(float x, float y);
+        // Quadratic Bezier, flattened into as few lines as the curvature needs
+        void quadTo(float controlX, float controlY, float x, float y);
+        void close();
+
+        // Write width * height coverage bytes
+        void accumulate(uint8_t* coverage) const;
+
+        int getWidth() const { return width_; }
+        int getHeight() const { return height_; }
+
+    private:
+        void addLine(float x0, float y0, float x1, float y1);
+
+        std::vector<float> area_;
+        int width_ = 0;
+        int height_ = 0;
+        float startX_ = 0, startY_ = 0;   // Current contour's first point
+        float penX_ = 0, penY_ = 0;
+    };
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include "ttf_reader.hpp"
+#include "glyph_rasterizer.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Fern {
+
+    // Decoded glyph outlines of one font, keyed by glyph index. Each glyph
+    // is read from the font once and kept as a path (move/line/quad verbs
+    // in font units, implied on-curve points resolved) in two shared
+    // arrays, so rasterizing it at a new size never parses the font again.
+    class OutlineCache {
+    public:
+        struct Outline {
+            uint32_t firstVerb = 0;
+            uint32_t verbCount = 0;
+            uint32_t firstPoint = 0;     // Index of the first (x, y) pair
+            int16_t xMin = 0, yMin = 0, xMax = 0, yMax = 0;
+        };
+
+        // Outline of glyphIndex, decoding it on first use. nullptr when the
+        // glyph has no outline we can draw (empty).
+        const Outline* get(TTFReader& reader, uint16_t glyphIndex);
+
+        // Replay an outline into the rasterizer. Font units are scaled and
+        // flipped so (originX, originY) in pixels is the bitmap's top-left.
+        void trace(const Outline& outline, GlyphRasterizer& rasterizer,
+                   float scale, float originX, float originY) const;
+
+        // Lookup counters; they keep counting across clear()
+        size_t getHits() const { return hits_; }
+        size_t getMisses() const { return misses_; }
+        size_t getOutlineCount() const { return outlines_.size(); }
+        size_t getByteSize() const;
+
+        void clear();
+
+    private:
+        enum Verb : uint8_t { MoveTo, LineTo, QuadTo };
+
+        struct Entry {
+            Outline outline;
+            bool drawable = false;
+        };
+
+        void decode(const SimpleGlyph& glyph, Outline& outline);
+        void addPoint(float x, float y) { points_.push_back(x); points_.push_back(y); }
+
+        std::unordered_map<uint16_t, Entry> outlines_;
+        std::vector<uint8_t> verbs_;
+        std::vector<float> points_;
+        SimpleGlyph scratch_;
+        size_t hits_ = 0;
+        size_t misses_ = 0;
+    };
+}
@@ -1,6 +1,11 @@
 #pragma once
 #include "ttf_reader.hpp"
+#include "glyph_atlas.hpp"
+#include "glyph_rasterizer.hpp"
+#include "outline_cache.hpp"
 #include "../core/canvas.hpp"
+#include "../text/utf8.hpp"
+#include <cmath>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -11,17 +16,62 @@ namespace Fern {
     
     class TTFFontRenderer {
     public:
-        struct RasterizedGlyph {
-            std::vector<uint8_t> bitmap;
+        // Where a rasterized glyph lives in its size's atlas, plus its metrics.
+        // Cheap to copy; the bitmap itself stays in the atlas.
+        struct GlyphHandle {
+            const GlyphAtlas* atlas = nullptr;
+            int atlasX = 0;
+            int atlasY = 0;
             int width = 0;
             int height = 0;
             int bearingX = 0;    // Left side bearing
             int bearingY = 0;    // Top side bearing
             int advance = 0;     // How much to advance cursor
+            
+            // Coverage row y of the glyph, valid until another glyph is added
+            const uint8_t* row(int y) const { return atlas->row(atlasY + y) + atlasX; }
+        };
+        
+        // Glyph cache counters. Hits, misses and evictions count glyph
+        // lookups and entries; bytes is what the atlases hold.
+        struct CacheStats {
+            size_t entries = 0;
+            size_t bytes = 0;
+            size_t hits = 0;
+            size_t misses = 0;
+            size_t evictions = 0;
+            
+            CacheStats& operator+=(const CacheStats& other);
+        };
+        
+        // How renderText caches and draws glyphs
+        enum class GlyphMode {
+            Coverage,        // Exact coverage bitmaps, one set per font size
+            DistanceField    // One signed distance field per glyph, drawn at any size
+        };
+        
+        // A string laid out once: its glyphs and where each one starts,
+        // ready to be drawn any number of times without measuring the text
+        // or looking glyphs up again. A run goes stale when the glyphs it
+        // points at are evicted or the glyph mode changes; check isCurrent().
+        struct GlyphRun {
+            struct Glyph {
+                GlyphHandle handle;
+                int x = 0;           // Pen position relative to the run's origin
+            };
+            
+            std::vector<Glyph> glyphs;   // Spaces take up room but have no entry
+            int width = 0;               // Same as getTextWidth()
+            int fontSize = 0;
+            GlyphMode mode = GlyphMode::Coverage;
+            uint64_t generation = 0;     // Glyph cache state the handles belong to
         };
         
         // Constructor - can throw std::runtime_error if font fails to load
         explicit TTFFontRenderer(const std::string& fontPath);
+        // Font already in memory; the data is not copied and must outlive
+        // the renderer
+        TTFFontRenderer(const uint8_t* data, size_t size);
         
         // Destructor
         ~TTFFontRenderer() = default;
@@ -35,53 +85,146 @@ namespace Fern {
         TTFFontRenderer& operator=(TTFFontRenderer&&) = default;
         
         // Main rendering functions
-        RasterizedGlyph rasterizeGlyph(char character, int fontSize);
+        // Coverage bitmap, rasterized into the atlas on first use. The
+        // reference stays valid until clearCache(), or with a cache budget
+        // set (this font's or the manager's), until the next glyph is
+        // rasterized in any font.
+        const GlyphHandle& getGlyph(uint32_t codepoint, int fontSize);
+        // text is UTF-8
         void renderText(Canvas* canvas, const std::string& text, int x, int y, 
                        int fontSize, uint32_t color);
         
-        // Text metrics
+        // renderText() in two steps, for text that is drawn every frame but
+        // rarely changes. (x, y) is the baseline origin, as for renderText().
+        void layoutText(const std::string& text, int fontSize, GlyphRun& run);
+        bool isCurrent(const GlyphRun& run) const {
+            return run.generation == cacheGeneration_ && run.mode == glyphMode_;
+        }
+        void drawRun(Canvas* canvas, const GlyphRun& run, int x, int y, uint32_t color);
+        
+        // Distance fields keep memory flat and never rasterize when the size
+        // changes (zooms, animations), for a small per-pixel cost and softer
+        // corners. Coverage stays crisper for small static text.
+        void setGlyphMode(GlyphMode mode) { glyphMode_ = mode; }
+        GlyphMode getGlyphMode() const { return glyphMode_; }
+        
+        // Text metrics, read from the font's metrics tables without
+        // rasterizing anything
+        int getAdvance(uint32_t codepoint, int fontSize);
+        int getKerning(uint32_t left, uint32_t right, int fontSize);
         int getTextWidth(const std::string& text, int fontSize);
-        int getTextHeight(int fontSize);
-        int getLineHeight(int fontSize);
+        int getAscent(int fontSize);      // Baseline to the top of tall glyphs
+        int getDescent(int fontSize);     // Baseline to the bottom, positive
+        int getTextHeight(int fontSize);  // Ascent plus descent
+        int getLineHeight(int fontSize);  // Text height plus the line gap
+        
+        // The same metrics unscaled, in font units, for callers that sum
+        // many advances and round once, as getTextWidth() does
+        int getAdvanceUnits(uint32_t codepoint);
+        int getKerningUnits(uint32_t left, uint32_t right);
+        int toPixels(int fontUnits, int fontSize) const { return scaled(fontUnits, fontSize); }
         
         // Font information
         bool isValid() const { return ttfReader_ != nullptr; }
         std::string getFontName() const;
         
         // Cache management
-        void clearCache() { glyphCache_.clear(); }
-        size_t getCacheSize() const { return glyphCache_.size(); }
+        // Bitmaps are cached per size; the size-independent outlines they
+        // are drawn from are cached separately, per glyph
+        void clearCache();
+        void clearOutlineCache() { outlines_.clear(); }
+        size_t getCacheSize() const;
+        const OutlineCache& getOutlineCache() const { return outlines_; }
+        
+        // Byte budget for this font's glyph bitmaps, 0 for no limit. Before
+        // a new glyph is rasterized, whole sizes (one atlas each) are evicted
+        // least recently used first until the cache fits. The size being
+        // drawn is kept even when it alone is over budget.
+        void setCacheBudget(size_t bytes) { cacheBudget_ = bytes; trimCache(nullptr); }
+        size_t getCacheBudget() const { return cacheBudget_; }
+        CacheStats getCacheStats() const;
+        size_t getCacheBytes() const { return cacheBytes_; }
+        
+        // Least recently used size, for budgets shared by several fonts.
+        // getOldestUse() is comparable across fonts; ~0 when nothing can be
+        // evicted. The size a glyph is being added to is never evicted.
+        uint64_t getOldestUse() const;
+        bool evictOldest();
         
     private:
-        std::unique_ptr<TTFReader> ttfReader_;
-        std::unordered_map<int, RasterizedGlyph> glyphCache_; // char + size -> glyph
+        // Scratch bitmap a glyph is rasterized into before it is packed
+        struct RasterizedGlyph {
+            std::vector<uint8_t> bitmap;
+            int width = 0;
+            int height = 0;
+            int bearingX = 0;
+            int bearingY = 0;
+        };
         
-        // 2D Point structure for outline generation
-        struct Point2D {
-            float x, y;
-            Point2D(float x = 0, float y = 0) : x(x), y(y) {}
+        // Atlas and glyph lookup for one font size
+        struct GlyphSet {
+            GlyphAtlas atlas;
+            std::unordered_map<uint32_t, GlyphHandle> glyphs; // codepoint -> glyph
+            size_t bytes = 0;       // Atlas plus lookup entries
+            uint64_t lastUse = 0;
+            
+            explicit GlyphSet(int atlasWidth) : atlas(atlasWidth) {}
         };
         
+        std::unique_ptr<TTFReader> ttfReader_;
+        std::unordered_map<int, GlyphSet> glyphSets_; // font size -> glyphs
+        size_t cacheBudget_ = 0;
+        size_t cacheBytes_ = 0;
+        const GlyphSet* adding_ = nullptr;   // Set in use while trimCache() runs
+        CacheStats cacheCounters_;   // Only hits, misses and evictions are kept here
+        uint64_t cacheGeneration_ = 1;   // Bumped whenever cached glyphs are dropped
+        GlyphRun scratchRun_;            // Layout of the string renderText() is drawing
+        RasterizedGlyph scratch_;
+        GlyphRasterizer rasterizer_;
+        OutlineCache outlines_;
+        
+        // Distance field mode: fields are built once at kFieldSize and kept
+        // in glyphSets_ under kFieldSetKey, which no real font size uses
+        static constexpr int kFieldSetKey = 0;
+        static constexpr int kFieldSize = 48;
+        static constexpr int kFieldRadius = 8;   // Field range in pixels at kFieldSize
+        static constexpr int kFieldPadding = 6;  // Room around each glyph for the outside ramp
+        GlyphMode glyphMode_ = GlyphMode::Coverage;
+        std::vector<uint8_t> fieldCoverage_;     // One row of a field glyph being drawn
+        std::vector<float> fieldRow_;            // Field row interpolated to the current y
+        std::vector<int> fieldColumns_;          // Field column left of each destination column
+        std::vector<float> fieldWeights_;        // And the weight of the one right of it
+        // BMP codepoint -> glyph index, in pages of 256 allocated as scripts
+        // are used; -1 until looked up. Other planes go to the cmap search.
+        std::vector<std::vector<int32_t>> glyphIndexPages_;
+        
+        void loadTables();
+        uint16_t getGlyphIndex(uint32_t codepoint);
+        
         // Internal rendering methods
-        void rasterizeGlyphOutline(const SimpleGlyph& glyph, int fontSize, RasterizedGlyph& output);
-        void rasterizeGlyphContours(const SimpleGlyph& glyph, RasterizedGlyph& output, float scale);
-        std::vector<Point2D> generateHighQualityContour(const SimpleGlyph& glyph, size_t startPt, size_t endPt, float scale);
-        Point2D quadraticBezier(const Point2D& start, const Point2D& control, const Point2D& end, float t);
-        void rasterizeContourLine(const std::vector<Point2D>& points, RasterizedGlyph& output);
-        void drawLine(const Point2D& p1, const Point2D& p2, RasterizedGlyph& output);
-        void fillInterior(RasterizedGlyph& output);
-        void fillContour(RasterizedGlyph& output); // Legacy method
-        
-        // Helper methods
-        int getCacheKey(char character, int fontSize) const { 
-            return (fontSize << 8) | static_cast<unsigned char>(character); 
-        }
+        void rasterizeGlyphOutline(const OutlineCache::Outline& outline, int fontSize,
+                                   RasterizedGlyph& output, int padding = 0);
+        void drawGlyph(Canvas* canvas, const GlyphHandle& glyph, int x, int y, uint32_t color);
+        void drawDistanceField(Canvas* canvas, const GlyphHandle& glyph, int x, int y,
+                               float scale, uint32_t color);
         
-        uint32_t blendPixel(uint32_t background, uint32_t foreground, uint8_t alpha);
+        // Glyph cache
+        GlyphSet& getGlyphSet(int fontSize);
+        const GlyphHandle& getGlyph(GlyphSet& set, uint32_t codepoint, int fontSize);
+        const GlyphHandle& getDistanceField(GlyphSet& set, uint32_t codepoint);
+        GlyphHandle packGlyph(GlyphSet& set, const RasterizedGlyph& glyph);
+        const GlyphHandle& addGlyph(GlyphSet& set, uint32_t codepoint, const GlyphHandle& handle);
+        void updateCacheBytes(GlyphSet& set);
+        void trimCache(GlyphSet* adding);
+        void rasterizeFallback(int fontSize, RasterizedGlyph& output);
         
         // Font metrics
-        float getScaleFactor(int fontSize) const { return static_cast<float>(fontSize) / 1000.0f; }
-        int getUnitsPerEm() const { return 1000; } // Most TTF fonts use 1000 units per em
+        float getScaleFactor(int fontSize) const {
+            return static_cast<float>(fontSize) / static_cast<float>(ttfReader_->getUnitsPerEm());
+        }
+        int scaled(int fontUnits, int fontSize) const {
+            return static_cast<int>(std::lround(fontUnits * getScaleFactor(fontSize)));
+        }
     };
     
     // Global font management
@@ -93,18 +236,40 @@ namespace Fern {
         }
         
         bool loadFont(const std::string& name, const std::string& fontPath);
+        bool loadFont(const std::string& name, const uint8_t* data, size_t size);
         TTFFontRenderer* getFont(const std::string& name);
         void setDefaultFont(const std::string& name);
         TTFFontRenderer* getDefaultFont();
         
         void clearAllCaches();
         
+        // Byte budget shared by all fonts' glyph caches, 0 for no limit.
+        // Checked whenever a managed font caches a glyph, as each font's
+        // own budget (TTFFontRenderer::setCacheBudget) is, which applies
+        // as well.
+        void setCacheBudget(size_t bytes);
+        size_t getCacheBudget() const { return cacheBudget_; }
+        
+        // Counters summed over all fonts, or for one font (zeros if unknown)
+        TTFFontRenderer::CacheStats getCacheStats() const;
+        TTFFontRenderer::CacheStats getCacheStats(const std::string& name) const;
+        
+        // Changes whenever a font is loaded or the default font changes, so
+        // callers holding a TTFFontRenderer* know to look it up again
+        uint64_t getGeneration() const { return generation_; }
+        
         // Check if any fonts are loaded
         bool hasAnyFont() const { return !fonts_.empty(); }
         
     private:
         std::unordered_map<std::string, std::unique_ptr<TTFFontRenderer>> fonts_;
         std::string defaultFontName_;
+        size_t cacheBudget_ = 0;
+        uint64_t generation_ = 1;
+        
+        // Called by fonts as they cache glyphs
+        void trimCaches();
+        friend class TTFFontRenderer;
         
         TTFFontManager() = default;
         ~TTFFontManager() = default;
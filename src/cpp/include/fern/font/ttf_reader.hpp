@@ -6,6 +6,7 @@
 #include <vector>
 #include <string>
 #include <cstdint>
+#include <cstddef>
 
 // TTF Header (Offset Table)
 struct TTFHeader {
@@ -74,32 +75,94 @@ struct CmapFormat4 {
     std::vector<uint16_t> glyphIdArray;
 };
 
+// One run of consecutive characters in a format 12 cmap
+struct CmapGroup {
+    uint32_t startCharCode;
+    uint32_t endCharCode;
+    uint32_t startGlyphID;
+};
+
+// Font-wide vertical metrics in font units
+struct TTFVerticalMetrics {
+    int16_t ascender = 0;
+    int16_t descender = 0;    // Negative: below the baseline
+    int16_t lineGap = 0;
+    int16_t xHeight = 0;      // 0 when the font does not say
+    int16_t capHeight = 0;
+};
+
+// Read-only view of font bytes. TrueType data is big-endian; reads past
+// the end return 0, so callers check has() before trusting a structure.
+struct TTFBytes {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    
+    bool has(size_t offset, size_t count) const {
+        return offset <= size && count <= size - offset;
+    }
+    uint8_t u8(size_t offset) const {
+        return has(offset, 1) ? data[offset] : 0;
+    }
+    uint16_t u16(size_t offset) const {
+        return has(offset, 2) ? static_cast<uint16_t>((data[offset] << 8) | data[offset + 1]) : 0;
+    }
+    int16_t i16(size_t offset) const { return static_cast<int16_t>(u16(offset)); }
+    uint32_t u32(size_t offset) const {
+        if (!has(offset, 4)) return 0;
+        return (static_cast<uint32_t>(data[offset]) << 24) | (static_cast<uint32_t>(data[offset + 1]) << 16) |
+               (static_cast<uint32_t>(data[offset + 2]) << 8) | data[offset + 3];
+    }
+};
+
 class TTFReader {
 private:
-    std::ifstream file;
-    bool littleEndian;
+    // The whole font, memory-mapped, copied in, or borrowed from the caller
+    TTFBytes bytes;
+    void* mapping = nullptr;
+    size_t mappingSize = 0;
+    std::vector<uint8_t> ownedData;
+    size_t cursor = 0;                 // Position for the sequential read functions
+    std::vector<TableEntry> tables;    // Table directory, indexed once at open
+    
     bool isLongFormat = false; 
     std::vector<uint32_t> glyphOffsets;
     
     // Font metrics
     uint16_t unitsPerEm = 1000; // Default value, will be read from head table
+    bool metricsLoaded = false;
+    TTFVerticalMetrics verticalMetrics;
+    uint32_t hmtxOffset = 0;
+    uint32_t hmtxLength = 0;
+    uint16_t numberOfHMetrics = 0;
+    uint32_t kernPairsOffset = 0;     // First pair of the kern format 0 subtable
+    uint32_t kernPairCount = 0;
     
     // cmap table data
     uint32_t cmapTableOffset = 0;
     bool cmapLoaded = false;
     CmapHeader cmapHeader;
     CmapFormat4 cmapFormat4;
+    std::vector<CmapGroup> cmapGroups;   // Format 12, sorted by character
+    uint16_t cmapFormat = 0;
     
-    // Byte swapping utilities
-    uint16_t swapUint16(uint16_t val);
-    uint32_t swapUint32(uint32_t val);
-    bool isLittleEndian();
+    bool indexTables();
+    bool parseSimpleGlyph(size_t offset, size_t end, SimpleGlyph& glyph, size_t& next);
+    bool parseCompositeGlyph(size_t offset, size_t end, SimpleGlyph& glyph, int depth);
+    bool readGlyph(int glyphIndex, SimpleGlyph& glyph, int depth);
 
 public:
     TTFReader();
     ~TTFReader();
     
+    TTFReader(const TTFReader&) = delete;
+    TTFReader& operator=(const TTFReader&) = delete;
+    
+    // Maps the file into memory where the platform allows, else reads it
+    // in one go. Fails if the file is missing or has no table directory.
     bool openFont(const std::string& filename);
+    // Parses a font already in memory. The data is not copied and must
+    // outlive the reader.
+    bool openFontData(const uint8_t* data, size_t size);
     void close();
     
     bool readHeader(TTFHeader& header);
@@ -121,6 +184,8 @@ public:
     bool readMultipleGlyphs(int count);
     void explainLocaTable();
     bool loadLocaTable(); 
+    // Composite glyphs (accented letters and the like) come back with
+    // their components merged into one outline
     bool readGlyphByIndex(int glyphIndex, SimpleGlyph& glyph);
     void readMultipleGlyphsByIndex(int startIndex, int count);
 
@@ -135,12 +200,23 @@ public:
     // cmap table functions
     bool loadCmapTable();
     bool parseCmapFormat4(uint32_t subtableOffset);
+    bool parseCmapFormat12(uint32_t subtableOffset);
+    // Binary search of the loaded subtable; 0 (.notdef) when unmapped
     uint16_t getGlyphIndex(uint32_t unicode);
     void printCmapInfo();
     
     // Font metrics functions
     bool loadHeadTable();
     uint16_t getUnitsPerEm() const { return unitsPerEm; }
+    
+    // hhea and hmtx are required, OS/2 and kern are used when present.
+    // The lookups below read straight from the font data, in font units.
+    bool loadMetricsTables();
+    bool hasMetrics() const { return metricsLoaded; }
+    uint16_t getAdvanceWidth(uint16_t glyphIndex) const;
+    int16_t getLeftSideBearing(uint16_t glyphIndex) const;
+    int16_t getKerning(uint16_t leftGlyph, uint16_t rightGlyph) const;
+    const TTFVerticalMetrics& getVerticalMetrics() const { return verticalMetrics; }
 };
 
 #endif
\ No newline at end of file
@@ -12,6 +12,7 @@
 
 #include "../core/canvas.hpp"
 #include <cstdint>
+#include <vector>
 
 namespace Fern {
     /**
@@ -26,6 +27,8 @@ namespace Fern {
         /**
          * @brief Fill the entire canvas with a solid color
          * 
+         * Only the current clip rectangle is filled when one is pushed.
+         * 
          * @param color 32-bit RGBA color value (0xAABBGGRR format)
          * 
          * @example
@@ -73,6 +76,12 @@ namespace Fern {
         /**
          * @brief Draw a rounded rectangle border/outline
          * 
+         * Only the band between the outer edge and an inner edge borderWidth
+         * pixels further in is drawn, so whatever is inside stays untouched.
+         * The inner corners use radius - borderWidth, which makes the border
+         * fit exactly around a roundedRect() of the inner size. A radius of 0
+         * gives a plain rectangular frame.
+         * 
          * @param x Left edge x-coordinate
          * @param y Top edge y-coordinate
          * @param width Rectangle width in pixels
@@ -103,14 +112,52 @@ namespace Fern {
          */
         void circle(int cx, int cy, int radius, uint32_t color);
         
+        /**
+         * @brief Draw a ring, or an arc of one
+         * 
+         * Fills the pixels farther than innerRadius and no farther than
+         * outerRadius from the center, within the angles given. Angles are in
+         * degrees: 0 points right and angles grow clockwise on screen, so 90
+         * points down. A sweep of 360 degrees or more draws the full ring. A ring
+         * drawn from radius r fits exactly around Draw::circle(cx, cy, r).
+         * 
+         * @param cx Center x-coordinate
+         * @param cy Center y-coordinate
+         * @param innerRadius Radius of the hole (-1 for a filled pie slice)
+         * @param outerRadius Outer radius in pixels
+         * @param startAngle Where the arc starts, in degrees
+         * @param endAngle Where the arc ends, in degrees
+         * @param color 32-bit RGBA color value
+         * 
+         * @example
+         * @code
+         * Draw::ring(100, 100, 40, 48, 0.0f, 360.0f, Colors::Gray);     // Track
+         * Draw::ring(100, 100, 40, 48, -90.0f, 45.0f, Colors::Primary); // 37.5% from the top
+         * @endcode
+         */
+        void ring(int cx, int cy, int innerRadius, int outerRadius,
+                  float startAngle, float endAngle, uint32_t color);
+        
+        /**
+         * @brief How the corners between polyline segments are drawn
+         */
+        enum class LineJoin {
+            Round,  ///< Rounded corner, same as drawing each segment with Draw::line
+            Miter,  ///< Sharp corner; very sharp angles fall back to Bevel
+            Bevel   ///< Corner cut off flat
+        };
+        
         /**
          * @brief Draw a line between two points
          * 
+         * The stroke covers every pixel within `thickness` of the line and has
+         * round ends, so it is 2 * thickness + 1 pixels wide.
+         * 
          * @param x1 Start point x-coordinate
          * @param y1 Start point y-coordinate
          * @param x2 End point x-coordinate
          * @param y2 End point y-coordinate
-         * @param thickness Line thickness in pixels
+         * @param thickness Line thickness in pixels (0 draws a one pixel line)
          * @param color 32-bit RGBA color value
          * 
          * @example
@@ -119,5 +166,27 @@ namespace Fern {
          * @endcode
          */
         void line(int x1, int y1, int x2, int y2, int thickness, uint32_t color);
+        
+        /**
+         * @brief Draw connected line segments through a list of points
+         * 
+         * Much faster than calling line() for every segment of a chart. Strokes
+         * are filled row by row as spans, and the ends of the polyline are round.
+         * With a translucent color, pixels where a segment meets a join are
+         * blended twice and look slightly darker.
+         * 
+         * @param points Points to connect, in order
+         * @param thickness Line thickness in pixels, as in line()
+         * @param color 32-bit RGBA color value
+         * @param join How corners between segments are drawn
+         * 
+         * @example
+         * @code
+         * std::vector<Point> trend = {{20, 80}, {60, 40}, {100, 55}, {140, 20}};
+         * Draw::polyline(trend, 1, Colors::Green, Draw::LineJoin::Miter);
+         * @endcode
+         */
+        void polyline(const std::vector<Point>& points, int thickness, uint32_t color,
+                      LineJoin join = LineJoin::Round);
     }
 }
\ No newline at end of file
@@ -0,0 +1,109 @@
+/**
+ * @file span.hpp
+ * @brief Horizontal span kernels used by the drawing primitives
+ *
+ * Every filled shape in Fern is drawn as a set of horizontal pixel runs
+ * (spans). This file provides the low-level kernels that write or blend
+ * those runs into a 32-bit pixel buffer. The fastest implementation the CPU
+ * supports is chosen once at runtime, so callers never deal with instruction
+ * sets.
+ *
+ * These functions do no clipping. Callers clip against the canvas first.
+ */
+
+#pragma once
+
+#include "../core/types.hpp"
+#include <cstdint>
+
+namespace Fern {
+    /**
+     * @namespace Span
+     * @brief Raw pixel-run kernels shared by Draw, DrawText and the canvas
+     */
+    namespace Span {
+        /**
+         * @brief Fill a run of pixels with one color
+         *
+         * Stores the color word as is, alpha included. Uses AVX2 or SSE2 on
+         * x86, NEON on ARM and SIMD128 on WebAssembly builds, falling back to a
+         * scalar loop elsewhere.
+         *
+         * @param dst First pixel of the run
+         * @param count Number of pixels to write (nothing happens if <= 0)
+         * @param color 32-bit color value
+         */
+        void fill(uint32_t* dst, int count, uint32_t color);
+
+        /**
+         * @brief Fill a rectangle of a pixel buffer row by row
+         *
+         * Rows that span the whole buffer width are filled as one run.
+         *
+         * @param buffer Top-left pixel of the buffer
+         * @param stride Pixels per buffer row
+         * @param rect Area to fill, already clipped to the buffer
+         * @param color 32-bit color value
+         */
+        void fillRect(uint32_t* buffer, int stride, const Rect& rect, uint32_t color);
+
+        /**
+         * @brief Composite one color over a run of pixels (source-over)
+         * 
+         * The color's alpha byte is its opacity. It is premultiplied once per
+         * call, and each pixel then costs one multiply-add per channel. Uses the
+         * same instruction sets as fill().
+         *
+         * @param dst First pixel of the run
+         * @param count Number of pixels to blend (nothing happens if <= 0)
+         * @param color 32-bit color value with straight (not premultiplied) alpha
+         */
+        void blend(uint32_t* dst, int count, uint32_t color);
+
+        /**
+         * @brief Composite one color over a run of pixels through a coverage mask
+         *
+         * Each pixel is blended with the color's alpha scaled by its mask byte.
+         * Used for anti-aliased glyph edges.
+         *
+         * @param dst First pixel of the run
+         * @param coverage One coverage byte per pixel, 255 meaning fully covered
+         * @param count Number of pixels
+         * @param color 32-bit color value with straight alpha
+         */
+        void blendMask(uint32_t* dst, const uint8_t* coverage, int count, uint32_t color);
+
+        /**
+         * @brief Draw a run of pixels in a color, respecting its alpha
+         *
+         * Opaque colors are stored with fill(), translucent ones go through
+         * blend(), and fully transparent ones draw nothing. This is what every
+         * Draw primitive uses.
+         */
+        inline void paint(uint32_t* dst, int count, uint32_t color) {
+            uint32_t alpha = color >> 24;
+            if (alpha == 0xFF) {
+                fill(dst, count, color);
+            } else if (alpha != 0) {
+                blend(dst, count, color);
+            }
+        }
+
+        /**
+         * @brief paint() every row of a rectangle
+         *
+         * @param buffer Top-left pixel of the buffer
+         * @param stride Pixels per buffer row
+         * @param rect Area to paint, already clipped to the buffer
+         * @param color 32-bit color value
+         */
+        void paintRect(uint32_t* buffer, int stride, const Rect& rect, uint32_t color);
+
+        /**
+         * @brief Name of the fill kernel selected for this CPU
+         *
+         * @return const char* "avx2", "sse2", "neon", "simd128" or "scalar"
+         */
+        const char* kernelName();
+    }
+}
@@ -3,6 +3,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 #include "../core/types.hpp"
 
 namespace Fern {
@@ -12,14 +13,31 @@ namespace Fern {
         virtual ~PlatformRenderer() = default;
         
         virtual void initialize(int width, int height) = 0;
-        virtual void present(uint32_t* pixelBuffer, int width, int height) = 0;
+        // Upload the damaged rectangles of pixelBuffer to the window. An empty
+        // damage list means nothing changed since the previous present.
+        virtual void present(uint32_t* pixelBuffer, int width, int height,
+                             const std::vector<Rect>& damage) = 0;
         virtual void shutdown() = 0;
         
+        // Window-sized buffer that present() uploads from directly. A canvas
+        // drawing into it skips the copy. nullptr if the renderer has none;
+        // it may change after a resize, before the resize callback runs.
+        virtual uint32_t* getPixelBuffer() { return nullptr; }
+        
         virtual void setTitle(const std::string& title) = 0;
         virtual void setSize(int width, int height) = 0;
         virtual bool shouldClose() = 0;
         
         virtual void pollEvents() = 0;
+        
+        // Block until window events are waiting (true), timeoutMs passes or
+        // wake() is called (false). A negative timeout waits indefinitely.
+        // Renderers that cannot wait report events at once, so the render
+        // loop keeps running every frame on them.
+        virtual bool waitEvents(int /*timeoutMs*/) { return true; }
+        
+        // Interrupt waitEvents(). May be called from any thread.
+        virtual void wake() {}
         virtual void setMouseCallback(std::function<void(int, int)> callback) = 0;
         virtual void setClickCallback(std::function<void(bool)> callback) = 0;
         virtual void setResizeCallback(std::function<void(int, int)> callback) = 0;
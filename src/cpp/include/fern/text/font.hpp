@@ -65,5 +65,17 @@ namespace Fern {
          *       use TextWidget instead.
          */
         void drawText(const char* text, int x, int y, int scale, uint32_t color);
+        
+        /**
+         * @brief Horizontal advance of one character as drawText() draws it
+         * 
+         * Lets callers that measure text incrementally (text inputs) agree
+         * with drawText() without re-walking the string.
+         * 
+         * @param codepoint Unicode codepoint of the character
+         * @param scale Scaling factor, as passed to drawText()
+         * @return Advance in pixels
+         */
+        int charWidth(uint32_t codepoint, int scale);
     }
 }
\ No newline at end of file
@@ -0,0 +1,134 @@
+/**
+ * @file measured_text.hpp
+ * @brief Editable line of text with incrementally maintained advances
+ *
+ * Text inputs need to know, every frame, how wide any stretch of their
+ * text is: for the cursor, for scrolling, for clipping. MeasuredText keeps
+ * the advance of every character in a gap buffer so that those questions
+ * never re-measure the string.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Fern {
+    /**
+     * @brief Per-character widths and byte offsets of a UTF-8 line
+     *
+     * Characters live in a gap buffer. Entries left of the gap store running
+     * totals from the start of the text, entries right of it running totals
+     * to the end. Editing at the gap is O(1) per character. Moving the gap
+     * costs one step per character it passes, which for an input field is
+     * the distance the cursor moved. Offsets are O(1) and position searches
+     * O(log n), whatever the length of the text.
+     *
+     * Widths are in whatever units the metrics return (font units for TTF,
+     * pixels for the bitmap font); the caller converts sums to pixels.
+     * Indices count characters (codepoints), not bytes.
+     *
+     * @example
+     * @code
+     * MeasuredText line;
+     * line.setMetrics([](uint32_t) { return 8; }, nullptr);
+     * line.assign("Hello");
+     * line.insert(5, " World");
+     * int32_t cursorX = line.offset(5);          // 40
+     * size_t index = line.indexAt(60);           // 7
+     * @endcode
+     */
+    class MeasuredText {
+    public:
+        /// Advance of one character
+        using AdvanceFunction = std::function<int32_t(uint32_t codepoint)>;
+        /// Adjustment between two adjacent characters; may be empty
+        using KerningFunction = std::function<int32_t(uint32_t left, uint32_t right)>;
+
+        /**
+         * @brief Set how characters are measured
+         *
+         * Takes effect at the next assign(); callers changing fonts should
+         * assign the text again.
+         */
+        void setMetrics(AdvanceFunction advance, KerningFunction kerning);
+
+        /// Replace the whole text, measuring every character once
+        void assign(const std::string& text);
+
+        /// Insert UTF-8 text before character @p index; returns characters added
+        size_t insert(size_t index, const std::string& text);
+
+        /// Remove @p count characters starting at @p index
+        void erase(size_t index, size_t count);
+
+        /// Number of characters
+        size_t size() const { return buffer_.size() - (gapEnd_ - gapStart_); }
+        bool empty() const { return size() == 0; }
+
+        /// Byte offset of character @p index in the UTF-8 text (index <= size())
+        size_t byteOffset(size_t index) const;
+
+        /// Width of everything before character @p index, kerning included
+        int32_t offset(size_t index) const;
+
+        /// Width of characters [first, last) drawn on their own, without the
+        /// kerning that joins @p first to the character before it
+        int32_t span(size_t first, size_t last) const;
+
+        /// Width of the whole text
+        int32_t width() const { return offset(size()); }
+
+        /// Last index whose offset is at most @p units (0 for negative input)
+        size_t indexAt(int32_t units) const;
+
+        /**
+         * @brief Binary search over character indices
+         *
+         * Returns the first index in [first, last] for which @p predicate is
+         * true, assuming it is false up to some point and true after it, or
+         * last + 1 if it never holds.
+         */
+        template <typename Predicate>
+        size_t partitionPoint(size_t first, size_t last, Predicate predicate) const {
+            size_t end = last + 1;
+            while (first < end) {
+                size_t middle = first + (end - first) / 2;
+                if (predicate(middle)) {
+                    end = middle;
+                } else {
+                    first = middle + 1;
+                }
+            }
+            return first;
+        }
+
+    private:
+        struct Entry {
+            uint32_t codepoint;
+            int32_t kerning;    // Joins this character to the previous one
+            int32_t units;      // Running width, from the start or to the end
+            uint32_t bytes;     // Running byte count, the same way
+        };
+
+        void moveGap(size_t index);
+        void reserveGap(size_t count);
+        void remeasureAfterGap();
+        int32_t leftUnits() const { return gapStart_ ? buffer_[gapStart_ - 1].units : 0; }
+        uint32_t leftBytes() const { return gapStart_ ? buffer_[gapStart_ - 1].bytes : 0; }
+        int32_t rightUnits() const { return gapEnd_ < buffer_.size() ? buffer_[gapEnd_].units : 0; }
+        uint32_t rightBytes() const { return gapEnd_ < buffer_.size() ? buffer_[gapEnd_].bytes : 0; }
+        const Entry& at(size_t index) const {
+            return buffer_[index < gapStart_ ? index : index + (gapEnd_ - gapStart_)];
+        }
+
+        std::vector<Entry> buffer_;
+        size_t gapStart_ = 0;
+        size_t gapEnd_ = 0;
+        AdvanceFunction advance_;
+        KerningFunction kerning_;
+    };
+}
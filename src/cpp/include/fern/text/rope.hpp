@@ -0,0 +1,91 @@
+/**
+ * @file rope.hpp
+ * @brief Text storage for large, frequently edited documents
+ *
+ * A std::string moves everything after an edit and has to be scanned to
+ * find a line. Rope keeps the text in small chunks in a balanced tree that
+ * also counts newlines, so edits and line lookups cost O(log n) however
+ * long the document is.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace Fern {
+    /**
+     * @brief UTF-8 text in a balanced tree of chunks
+     *
+     * Chunks of up to kMaxChunk bytes are kept in document order in a treap.
+     * Every node stores the byte and newline totals of its subtree, which is
+     * what lets lineStart() and lineOf() descend straight to the right chunk.
+     * Offsets are in bytes; the rope never splits or inspects characters, so
+     * callers keep offsets on character boundaries.
+     *
+     * @example
+     * @code
+     * Rope document;
+     * document.assign("first\nsecond\n");
+     * document.insert(document.lineStart(1), "new ");
+     * std::string line = document.line(1);         // "new second"
+     * size_t count = document.lineCount();         // 3, the last one empty
+     * @endcode
+     */
+    class Rope {
+    public:
+        /// Largest chunk; edits inside a chunk with room never rebalance
+        static constexpr size_t kMaxChunk = 512;
+
+        Rope();
+        ~Rope();
+        Rope(Rope&&) noexcept;
+        Rope& operator=(Rope&&) noexcept;
+        Rope(const Rope&) = delete;
+        Rope& operator=(const Rope&) = delete;
+
+        /// Replace the whole document
+        void assign(const std::string& text);
+        /// Insert @p text before byte @p offset (clamped to size())
+        void insert(size_t offset, const std::string& text);
+        /// Remove @p count bytes starting at @p offset
+        void erase(size_t offset, size_t count);
+
+        /// Length in bytes
+        size_t size() const;
+        bool empty() const { return size() == 0; }
+        /// Number of lines: newlines plus one
+        size_t lineCount() const;
+
+        /// Byte offset where @p line starts; size() past the last line
+        size_t lineStart(size_t line) const;
+        /// Byte offset of the newline ending @p line, or size() for the last
+        size_t lineEnd(size_t line) const;
+        /// Line containing byte @p offset
+        size_t lineOf(size_t offset) const;
+
+        /// Copy of @p count bytes starting at @p offset
+        std::string substr(size_t offset, size_t count) const;
+        /// Text of @p line without its newline
+        std::string line(size_t line) const;
+        /// The whole document
+        std::string str() const { return substr(0, size()); }
+
+    private:
+        struct Node;
+        using NodePtr = std::unique_ptr<Node>;
+
+        NodePtr makeNode(std::string text);
+        NodePtr build(const std::string& text, size_t offset, size_t count);
+        static NodePtr merge(NodePtr left, NodePtr right);
+        static void split(NodePtr node, size_t offset, NodePtr& left, NodePtr& right);
+        static bool insertInPlace(Node* node, size_t offset, const std::string& text);
+        static bool eraseInPlace(Node* node, size_t offset, size_t count);
+        static void append(const Node* node, size_t offset, size_t count, std::string& output);
+
+        NodePtr root_;
+        uint32_t seed_ = 0x9E3779B9u;   // Treap priorities
+    };
+}
@@ -0,0 +1,93 @@
+/**
+ * @file utf8.hpp
+ * @brief UTF-8 decoding for the text rendering path
+ *
+ * Strings in Fern are UTF-8. Code that draws or measures text walks them
+ * one codepoint at a time with these helpers instead of one byte at a time.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Fern {
+    /**
+     * @namespace Utf8
+     * @brief Codepoint iteration over UTF-8 strings
+     */
+    namespace Utf8 {
+        /// Substituted for bytes that do not form a valid sequence
+        constexpr uint32_t kReplacement = 0xFFFD;
+
+        /**
+         * @brief Decode the codepoint starting at byte @p i and step past it
+         *
+         * Malformed input (stray continuation bytes, truncated, overlong or
+         * surrogate sequences) decodes to kReplacement and consumes a single
+         * byte, so decoding always makes progress.
+         *
+         * @param text UTF-8 bytes
+         * @param length Number of bytes in @p text
+         * @param i Byte index, advanced to the next codepoint (must be < length)
+         * @return The decoded codepoint
+         *
+         * @example
+         * @code
+         * for (size_t i = 0; i < text.size();) {
+         *     uint32_t codepoint = Utf8::decode(text.data(), text.size(), i);
+         * }
+         * @endcode
+         */
+        inline uint32_t decode(const char* text, size_t length, size_t& i) {
+            const unsigned char* s = reinterpret_cast<const unsigned char*>(text);
+            uint32_t lead = s[i];
+            if (lead < 0x80) {
+                i++;
+                return lead;
+            }
+
+            // Sequence length and smallest codepoint it may encode
+            size_t count;
+            uint32_t minimum;
+            if ((lead & 0xE0) == 0xC0) {
+                count = 2; minimum = 0x80; lead &= 0x1F;
+            } else if ((lead & 0xF0) == 0xE0) {
+                count = 3; minimum = 0x800; lead &= 0x0F;
+            } else if ((lead & 0xF8) == 0xF0) {
+                count = 4; minimum = 0x10000; lead &= 0x07;
+            } else {
+                i++;
+                return kReplacement;
+            }
+
+            if (length - i < count) {
+                i++;
+                return kReplacement;
+            }
+            uint32_t codepoint = lead;
+            for (size_t n = 1; n < count; n++) {
+                uint32_t next = s[i + n];
+                if ((next & 0xC0) != 0x80) {
+                    i++;
+                    return kReplacement;
+                }
+                codepoint = (codepoint << 6) | (next & 0x3F);
+            }
+            if (codepoint < minimum || codepoint > 0x10FFFF ||
+                (codepoint >= 0xD800 && codepoint <= 0xDFFF)) {
+                i++;
+                return kReplacement;
+            }
+
+            i += count;
+            return codepoint;
+        }
+
+        /// decode() over a std::string
+        inline uint32_t decode(const std::string& text, size_t& i) {
+            return decode(text.data(), text.size(), i);
+        }
+    }
+}
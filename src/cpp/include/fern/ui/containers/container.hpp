@@ -102,6 +102,8 @@ namespace Fern {
         ContainerWidget(uint32_t color, int x, int y, int width, int height, 
                      std::shared_ptr<Widget> child);
         
+        ~ContainerWidget() override;
+        
         /**
          * @brief Render the container and its child
          */
@@ -123,6 +125,16 @@ namespace Fern {
         void setChild(std::shared_ptr<Widget> child);
         
     protected:
+        /**
+         * @brief The container's size, with unset dimensions taken from the child
+         */
+        Size onMeasure(const Constraints& constraints) override;
+        
+        /**
+         * @brief Take on @p bounds and lay the child out in its top-left corner
+         */
+        void onArrange(const Rect& bounds) override;
+        
         uint32_t color_;                    ///< Background color
         std::shared_ptr<Widget> child_;     ///< Child widget
     };
@@ -47,38 +47,82 @@ namespace Fern {
      */
     class LayoutWidget : public Widget {
     public:
+        static constexpr WidgetCapability kCapability = WidgetCapability::Layout;
+        using CapabilityClass = LayoutWidget;
+        
         /**
          * @brief Construct a new Layout Widget
          * 
          * @param x X position
          * @param y Y position
-         * @param width Width in pixels
-         * @param height Height in pixels
+         * @param width Width in pixels, or 0 to size from the content and parent
+         * @param height Height in pixels, or 0 to size from the content and parent
          */
-        LayoutWidget(int x, int y, int width, int height) {
+        LayoutWidget(int x, int y, int width, int height)
+            : explicitWidth_(width), explicitHeight_(height) {
+            addCapabilities(WidgetCapability::Layout);
             x_ = x;
             y_ = y;
             width_ = width;
             height_ = height;
         }
         
-        virtual ~LayoutWidget() = default;
+        virtual ~LayoutWidget() {
+            for (auto& child : children_) {
+                if (child->getParent() == this) adopt(*child, nullptr);
+            }
+        }
         
         /**
          * @brief Render all child widgets
+         * 
+         * Children that lie completely outside the current clip are skipped.
+         * Layouts don't clip to their own bounds, since children such as an
+         * open dropdown are allowed to overflow their row.
          */
-        void render() override {        
+        void render() override {
             for (auto& child : children_) {
+                // Unsized children can't be culled, so always draw them
+                if (child->getWidth() > 0 && child->getHeight() > 0 &&
+                    globalCanvas->isClippedOut(child->getX(), child->getY(),
+                                               child->getWidth(), child->getHeight())) {
+                    continue;
+                }
                 child->render();
             }
         }
         
         /**
          * @brief Update the layout arrangement of children
+         * 
+         * Needed only after changing a child in a way the layout can't see;
+         * adding children and resizing layouts update it already.
          */
         void updateLayout() {
-            arrangeChildren();
+            invalidateLayout();
         }
+        
+        /**
+         * @brief Hold back layout of this layout and its children until endUpdate()
+         * 
+         * Each add() normally lays out right away, which costs a pass over
+         * every child so far. Between beginUpdate() and endUpdate() changes
+         * are only recorded, and endUpdate() lays out once. Updates nest;
+         * the LayoutBatch guard pairs the calls automatically.
+         * 
+         * @example
+         * @code
+         * list->beginUpdate();
+         * for (const auto& row : rows) list->add(makeRow(row));
+         * list->endUpdate();
+         * @endcode
+         */
+        using Widget::beginUpdate;
+        
+        /**
+         * @brief Lay out once for all changes made since beginUpdate()
+         */
+        using Widget::endUpdate;
 
         /**
          * @brief Handle input events and forward to children
@@ -96,7 +140,9 @@ namespace Fern {
         }
         
         /**
-         * @brief Set the position and update child positions
+         * @brief Set the position and move the children along
+         * 
+         * The children keep their arrangement, so nothing is measured.
          * 
          * @param x New X position
          * @param y New Y position
@@ -104,6 +150,7 @@ namespace Fern {
         void setPosition(int x, int y) override {
             int deltaX = x - x_;
             int deltaY = y - y_;
+            if (deltaX == 0 && deltaY == 0) return;
             
             x_ = x;
             y_ = y;
@@ -114,26 +161,71 @@ namespace Fern {
         }
         
         /**
-         * @brief Resize the layout and rearrange children
+         * @brief Give the layout a fixed size and rearrange children
          * 
          * @param width New width in pixels
          * @param height New height in pixels
          */
         void resize(int width, int height) override {
+            explicitWidth_ = width;
+            explicitHeight_ = height;
             width_ = width;
             height_ = height;
-            arrangeChildren();
+            invalidateLayout();
         }
         
     protected:
         /**
          * @brief Abstract method to arrange child widgets
          * 
-         * Subclasses must implement this to define their specific layout algorithm.
+         * Subclasses must implement this to define their specific layout
+         * algorithm: measure each child, then arrange() it within the
+         * layout's current bounds. Children whose layout is still valid
+         * return their cached size and are only moved.
          */
         virtual void arrangeChildren() = 0;
         
+        /**
+         * @brief Take on the bounds given by the parent and arrange the children
+         */
+        void onArrange(const Rect& bounds) override {
+            x_ = bounds.x;
+            y_ = bounds.y;
+            width_ = bounds.width;
+            height_ = bounds.height;
+            arrangeChildren();
+        }
+        
+        /**
+         * @brief Append a child and record this layout as its parent
+         */
+        void addChild(std::shared_ptr<Widget> child) {
+            adopt(*child, this);
+            children_.push_back(std::move(child));
+        }
+        
+        /**
+         * @brief Remove all children, detaching them from this layout
+         */
+        void clearChildren() {
+            for (auto& child : children_) {
+                if (child->getParent() == this) adopt(*child, nullptr);
+            }
+            children_.clear();
+        }
+        
+        /**
+         * @brief Apply the fixed size, if any, to a size computed from the content
+         */
+        Size withExplicitSize(Size size) const {
+            if (explicitWidth_ > 0) size.width = explicitWidth_;
+            if (explicitHeight_ > 0) size.height = explicitHeight_;
+            return size;
+        }
+        
         std::vector<std::shared_ptr<Widget>> children_;  ///< Child widgets
+        int explicitWidth_;   ///< Size from the constructor or resize(); 0 when not fixed
+        int explicitHeight_;
     };
 
     /**
@@ -175,7 +267,14 @@ namespace Fern {
          */
         void onWindowResize(int newWidth, int newHeight) override;
         
+        ResponsiveWidget* asResponsive() override { return this; }
+        
     protected:
+        /**
+         * @brief Fill the space offered, or wrap the child where it is unbounded
+         */
+        Size onMeasure(const Constraints& constraints) override;
+        
         /**
          * @brief Arrange child at center position
          */
@@ -230,6 +329,11 @@ namespace Fern {
          */
         void addAll(const std::vector<std::shared_ptr<Widget>>& children);
         
+        /**
+         * @brief Remove all child widgets from the column
+         */
+        void clear();
+        
         /**
          * @brief Set the main axis (vertical) alignment
          * 
@@ -245,10 +349,21 @@ namespace Fern {
         void setCrossAxisAlignment(CrossAxisAlignment alignment);
         
     protected:
+        /**
+         * @brief Fill the height offered, or stack the children where it is unbounded
+         * 
+         * The width is that of the widest child, or all of it with
+         * CrossAxisAlignment::Stretch.
+         */
+        Size onMeasure(const Constraints& constraints) override;
+        
         /**
          * @brief Arrange children in a vertical column
          */
         void arrangeChildren() override;
+        
+    private:
+        Constraints childConstraints(int width) const;
     };
 
     /**
@@ -311,11 +426,27 @@ namespace Fern {
          */
         void addAll(const std::vector<std::shared_ptr<Widget>>& children);
         
+        /**
+         * @brief Remove all child widgets from the row
+         */
+        void clear();
+        
     protected:
+        /**
+         * @brief Fill the width offered, or line the children up where it is unbounded
+         * 
+         * The height is that of the tallest child, or all of it with
+         * CrossAxisAlignment::Stretch.
+         */
+        Size onMeasure(const Constraints& constraints) override;
+        
         /**
          * @brief Arrange children in a horizontal row
          */
         void arrangeChildren() override;
+        
+    private:
+        Constraints childConstraints(int height) const;
     };
 
     /**
@@ -336,6 +467,9 @@ namespace Fern {
      */
     class ExpandedWidget : public LayoutWidget {
     public:
+        static constexpr WidgetCapability kCapability = WidgetCapability::Expanded;
+        using CapabilityClass = ExpandedWidget;
+        
         /**
          * @brief Construct a new Expanded Widget
          * 
@@ -357,6 +491,11 @@ namespace Fern {
         void render() override;
         
     protected:
+        /**
+         * @brief Take the child's size; Row and Column then impose the flex share
+         */
+        Size onMeasure(const Constraints& constraints) override;
+        
         /**
          * @brief Arrange the child to fill available space
          */
@@ -417,6 +556,11 @@ namespace Fern {
         void add(std::shared_ptr<Widget> child);
         
     protected:
+        /**
+         * @brief The fixed size, or the child's size plus the padding
+         */
+        Size onMeasure(const Constraints& constraints) override;
+        
         /**
          * @brief Arrange child with padding applied
          */
@@ -443,6 +587,9 @@ namespace Fern {
      */
     class SpacingWidget : public Widget {
     public:
+        static constexpr WidgetCapability kCapability = WidgetCapability::Spacing;
+        using CapabilityClass = SpacingWidget;
+        
         /**
          * @brief Construct a new Spacing Widget
          * 
@@ -188,6 +188,7 @@ namespace Fern {
         
         void renderMainButton();
         void renderDropdown();
+        void renderBorder(int top, int height);
         void renderArrow();
         void renderText(const std::string& text, int x, int y, uint32_t color);
         bool isPointInMainButton(int x, int y) const;
@@ -197,6 +198,7 @@ namespace Fern {
         int calculateOptimalWidth() const;
         int getDropdownHeight() const;
         int getItemHeight() const;
+        int getTextAreaWidth() const;
     };
     
     // Factory function
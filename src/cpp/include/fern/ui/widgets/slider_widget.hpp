@@ -36,7 +36,7 @@ namespace Fern {
          * @brief Construct a new Slider Style with default values
          * 
          * Default style includes gray track, blue fill, white thumb with
-         * hover effects, and visible value display.
+         * hover effects, visible value display, and no background.
          */
         SliderStyle()
             : trackColor_(0xFF606060)       // Gray track
@@ -47,6 +47,8 @@ namespace Fern {
             , showValue_(true)
             , textColor_(0xFFFFFFFF)        // White text
             , textScale_(1)
+            , backgroundColor_(0x00000000)  // No background
+            , hasBackground_(false)
         {}
         
         // Fluent interface for easy configuration
@@ -58,6 +60,9 @@ namespace Fern {
         SliderStyle& showValue(bool show) { showValue_ = show; return *this; }
         SliderStyle& textColor(uint32_t color) { textColor_ = color; return *this; }
         SliderStyle& textScale(int scale) { textScale_ = scale; return *this; }
+        // Fills the slider, thumb overhang and value text area before drawing,
+        // so the previous thumb and value are erased without a full redraw
+        SliderStyle& backgroundColor(uint32_t color) { backgroundColor_ = color; hasBackground_ = true; return *this; }
         
         // Getters
         uint32_t getTrackColor() const { return trackColor_; }
@@ -68,6 +73,8 @@ namespace Fern {
         bool getShowValue() const { return showValue_; }
         uint32_t getTextColor() const { return textColor_; }
         int getTextScale() const { return textScale_; }
+        uint32_t getBackgroundColor() const { return backgroundColor_; }
+        bool hasBackground() const { return hasBackground_; }
         
     private:
         uint32_t trackColor_;
@@ -78,6 +85,8 @@ namespace Fern {
         bool showValue_;
         uint32_t textColor_;
         int textScale_;
+        uint32_t backgroundColor_;
+        bool hasBackground_;
     };
     
     class SliderConfig {
@@ -0,0 +1,178 @@
+#pragma once
+
+#include "widget.hpp"
+#include "text_input_widget.hpp"
+#include "../../core/signal.hpp"
+#include "../../font/ttf_font_renderer.hpp"
+#include "../../text/measured_text.hpp"
+#include "../../text/rope.hpp"
+#include <cstdint>
+#include <string>
+#include <memory>
+#include <vector>
+
+namespace Fern {
+
+    /**
+     * @brief Configuration container for TextAreaWidget positioning and setup
+     *
+     * Text areas share TextInputStyle with single-line inputs, so the two can
+     * be themed together.
+     *
+     * @example Read-only log view:
+     * @code
+     * auto config = TextAreaConfig(20, 20, 600, 400)
+     *     .readOnly(true)
+     *     .style(TextInputStyle().useTTFFont("mono").fontSize(14));
+     * @endcode
+     */
+    class TextAreaConfig {
+    public:
+        TextAreaConfig(int x, int y, int width, int height)
+            : x_(x), y_(y), width_(width), height_(height)
+            , readOnly_(false)
+        {}
+
+        // Fluent interface
+        TextAreaConfig& readOnly(bool value) { readOnly_ = value; return *this; }
+        TextAreaConfig& style(const TextInputStyle& s) { style_ = s; return *this; }
+
+        // Getters
+        int getX() const { return x_; }
+        int getY() const { return y_; }
+        int getWidth() const { return width_; }
+        int getHeight() const { return height_; }
+        bool isReadOnly() const { return readOnly_; }
+        const TextInputStyle& getStyle() const { return style_; }
+
+        // Position/size setters
+        void setPosition(int x, int y) { x_ = x; y_ = y; }
+        void setSize(int width, int height) { width_ = width; height_ = height; }
+
+    private:
+        int x_, y_, width_, height_;
+        bool readOnly_;
+        TextInputStyle style_;
+    };
+
+    /**
+     * @brief Multi-line text editor for documents of any length
+     *
+     * The document lives in a Rope, so an edit or a jump to a line costs
+     * O(log n) however long it is. Only the lines on screen are laid out:
+     * each keeps its text, its character widths and, for TTF fonts, a glyph
+     * run. An edit lays out again only the lines it touched, and a frame
+     * draws only the visible lines, clipped to the widget. Lines are not
+     * wrapped; the view scrolls sideways to follow the cursor.
+     *
+     * @example
+     * @code
+     * auto log = TextArea(TextAreaConfig(0, 0, 800, 600).readOnly(true));
+     * log->appendText("server started\n");
+     * log->scrollToLine(log->getLineCount() - 1);
+     * @endcode
+     */
+    class TextAreaWidget : public Widget {
+    public:
+        TextAreaWidget(const TextAreaConfig& config);
+
+        void render() override;
+        bool handleInput(const InputState& input) override;
+
+        int getWidth() const override;
+        int getHeight() const override;
+        void setPosition(int x, int y) override;
+        int getX() const override;
+        int getY() const override;
+        void resize(int width, int height) override;
+
+        // Text manipulation; lines are separated by '\n'
+        void setText(const std::string& text);
+        std::string getText() const { return document_.str(); }
+        void appendText(const std::string& text);
+        void clear() { setText(""); }
+        const Rope& getDocument() const { return document_; }
+        size_t getLineCount() const { return document_.lineCount(); }
+
+        // Cursor and scrolling; columns count characters, not bytes
+        size_t getCursorLine() const { return cursorLine_; }
+        size_t getCursorColumn() const { return cursorColumn_; }
+        void setCursor(size_t line, size_t column);
+        void scrollToLine(size_t line);
+        size_t getFirstVisibleLine() const { return firstLine_; }
+
+        // Focus management
+        void setFocus(bool focused);
+        bool isFocused() const { return isFocused_; }
+
+        void setReadOnly(bool readOnly) { config_.readOnly(readOnly); }
+        bool isReadOnly() const { return config_.isReadOnly(); }
+
+        // Signals. Text changes carry no payload: copying a large document
+        // on every keystroke is what this widget exists to avoid.
+        Signal<> onTextChanged;
+        Signal<bool> onFocusChanged;
+
+    private:
+        // One laid-out line. TTF widths are in font units, bitmap widths
+        // in pixels.
+        struct LineLayout {
+            std::string text;               // Without the newline
+            MeasuredText widths;
+            TTFFontRenderer::GlyphRun run;  // TTF only
+            bool measured = false;
+            bool runDirty = true;
+        };
+
+        TextAreaConfig config_;
+        Rope document_;
+        size_t cursorLine_ = 0;
+        size_t cursorColumn_ = 0;
+        int preferredX_ = -1;               // Kept across up/down moves; -1 when unset
+        bool isFocused_ = false;
+
+        // Layouts of lines [windowLine_, windowLine_ + lines_.size()), the
+        // ones on screen as of the last syncWindow(), plus one line off
+        // screen that an edit needed. firstLine_ is the line scrolled to.
+        size_t firstLine_ = 0;
+        size_t windowLine_ = 0;
+        std::vector<LineLayout> lines_;
+        LineLayout detached_;
+        size_t detachedLine_ = SIZE_MAX;
+        int scrollX_ = 0;
+
+        TTFFontRenderer* font_ = nullptr;   // Null when drawing with the bitmap font
+        uint64_t fontsGeneration_ = 0;
+        MeasuredText::AdvanceFunction advance_;
+        MeasuredText::KerningFunction kerning_;
+
+        void updateFont();
+        int toPixels(int32_t units) const;
+        int lineHeight() const;
+        int visibleLineCount() const;
+        Rect textArea() const;
+
+        void syncWindow();
+        LineLayout& layoutOf(size_t line);
+        void measureLine(size_t line, LineLayout& layout);
+        void linesChanged(size_t line, size_t removed, size_t added);
+        void invalidateLayouts();
+
+        void handleKeyInput(const InputState& input);
+        void insertText(const std::string& text);
+        void deleteCharacter(bool forward);
+        void moveHorizontally(int direction);
+        void moveVertically(int direction);
+        size_t columnAt(const LineLayout& layout, int x) const;
+        void scrollToCursor();
+        bool isPointInWidget(int x, int y) const;
+
+        void renderBackground();
+        void renderBorder();
+        void renderLines(const Rect& area);
+        void renderCursor(const Rect& area);
+    };
+
+    // Helper function with class-based config
+    std::shared_ptr<TextAreaWidget> TextArea(const TextAreaConfig& config, bool addToManager = true);
+}
@@ -3,6 +3,8 @@
 #include "widget.hpp"
 #include "../../core/signal.hpp"
 #include "../../font/font.hpp"
+#include "../../font/ttf_font_renderer.hpp"
+#include "../../text/measured_text.hpp"
 #include <string>
 #include <functional>
 #include <memory>
@@ -43,11 +45,11 @@ namespace Fern {
          * black text, and medium font size suitable for bitmap fonts.
          */
         TextInputStyle() 
-            : backgroundColor_(0xFFFFFF)    // White
-            , borderColor_(0x888888)        // Gray  
-            , focusBorderColor_(0x0066CC)   // Blue
-            , textColor_(0x000000)          // Black
-            , cursorColor_(0x000000)        // Black
+            : backgroundColor_(0xFFFFFFFF)  // White
+            , borderColor_(0xFF888888)      // Gray  
+            , focusBorderColor_(0xFF0066CC) // Blue
+            , textColor_(0xFF000000)        // Black
+            , cursorColor_(0xFF000000)      // Black
             , borderWidth_(1)
             , padding_(4)
             , fontSize_(2)                  // Good size for bitmap font
@@ -235,19 +237,31 @@ namespace Fern {
     private:
         TextInputConfig config_;
         std::string text_;
-        size_t cursorPosition_;
+        size_t cursorPosition_;         // In characters, not bytes
         bool isFocused_;
         bool showCursor_;
         uint32_t cursorBlinkTimer_;
         static constexpr uint32_t CURSOR_BLINK_INTERVAL = 500; // milliseconds
         
+        // Widths of text_ and the placeholder, kept in step with every edit
+        // so that scrolling and the cursor never re-measure the text. TTF
+        // widths are in font units; bitmap widths are in pixels.
+        MeasuredText model_;
+        MeasuredText placeholderModel_;
+        TTFFontRenderer* font_ = nullptr;   // Null when drawing with the bitmap font
+        uint64_t fontsGeneration_ = 0;
+        
         // Helper methods
         void handleKeyInput(const InputState& input);
         void handleTextInput(const InputState& input);
         void moveCursor(int direction);
         void insertText(const std::string& text);
         void deleteCharacter(bool forward = false);
-        int getTextWidth(const std::string& text) const;
+        void updateMetrics();
+        int toPixels(int32_t units) const;
+        void visibleRange(size_t& first, size_t& last) const;
+        size_t fittingLength(const MeasuredText& text, int maxWidth) const;
+        void drawString(const std::string& text, int x, int y, uint32_t color);
         int getCursorX() const;
         void updateCursorBlink();
         bool isPointInWidget(int x, int y) const;
@@ -255,9 +269,6 @@ namespace Fern {
         void renderCursor();
         void renderBorder();
         void renderBackground();
-        std::string clipTextToWidth(const std::string& text, int maxWidth) const;
-        std::string getVisibleText(const std::string& text, int availableWidth) const;
-        int getCharWidth(char c) const;
     };
     
     // Helper function with class-based config
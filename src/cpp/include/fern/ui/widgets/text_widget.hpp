@@ -4,6 +4,7 @@
 #include "../../core/input.hpp"
 #include "../../core/types.hpp"
 #include "../../font/font.hpp"
+#include "../../font/ttf_font_renderer.hpp"
 
 namespace Fern {
     
@@ -272,7 +273,7 @@ namespace Fern {
         void setText(const std::string& text);
         void setSize(int size);
         void setColor(uint32_t color);
-        void setFontType(FontType type) { fontType_ = type; }
+        void setFontType(FontType type);
         void setConfig(const TextConfig& config);
         
         // Rendering methods for different font types
@@ -293,6 +294,15 @@ namespace Fern {
         FontType fontType_;
         TextConfig config_;
         
+        // TTF text is laid out once and redrawn from the run until the
+        // text, size or font changes
+        TTFFontRenderer::GlyphRun run_;
+        TTFFontRenderer* runFont_ = nullptr;
+        uint64_t runFontsGeneration_ = 0;
+        bool runDirty_ = true;
+        
+        TTFFontRenderer* resolveFont();
+        TTFFontRenderer* layout();
         void updateDimensions();
         void renderBackground();
         void renderShadow();
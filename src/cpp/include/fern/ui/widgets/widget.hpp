@@ -1,9 +1,41 @@
 #pragma once
 
 #include "../../core/types.hpp"
+#include <cstdint>
 #include <functional>
+#include <type_traits>
 
 namespace Fern {
+    void requestRedraw();
+    class ResponsiveWidget;
+    
+    /**
+     * @brief What kind of widget something is, as bits set at construction
+     * 
+     * Layouts and the widget manager test these bits rather than asking
+     * the compiler for run-time type information: a test is a single AND,
+     * and the library builds with RTTI turned off.
+     * 
+     * @example
+     * @code
+     * if (widget->hasCapability(WidgetCapability::Focusable)) { ... }
+     * if (auto expanded = widgetCast<ExpandedWidget>(child.get())) {
+     *     totalFlex += expanded->getFlex();
+     * }
+     * @endcode
+     */
+    enum class WidgetCapability : uint32_t {
+        None      = 0,
+        Layout    = 1u << 0,  ///< Derives from LayoutWidget
+        Expanded  = 1u << 1,  ///< Is an ExpandedWidget
+        Spacing   = 1u << 2,  ///< Is a SpacingWidget
+        Focusable = 1u << 3   ///< Takes keyboard focus, like text inputs
+    };
+    
+    inline WidgetCapability operator|(WidgetCapability a, WidgetCapability b) {
+        return static_cast<WidgetCapability>(static_cast<uint32_t>(a) | static_cast<uint32_t>(b));
+    }
+    
     /**
      * @brief Base class for all UI widgets in the Fern framework
      * 
@@ -40,7 +72,7 @@ namespace Fern {
         /**
          * @brief Virtual destructor for proper cleanup
          */
-        virtual ~Widget() = default;
+        virtual ~Widget();
         
         /**
          * @brief Render the widget to the screen
@@ -105,10 +137,238 @@ namespace Fern {
          */
         virtual int getHeight() const { return height_; }
         
+        /**
+         * @brief Measure pass: the size the widget wants within @p constraints
+         * 
+         * Layouts call this on each child before placing it. The results
+         * for the last two constraints are cached, which covers a layout
+         * measuring its children once while measuring itself and once while
+         * arranging them. Asking again costs nothing until invalidateLayout()
+         * is called on this widget or a descendant.
+         * 
+         * @param constraints Smallest and largest size the parent allows
+         * @return Size The widget's preferred size, within @p constraints
+         */
+        Size measure(const Constraints& constraints);
+        
+        /**
+         * @brief Arrange pass: place the widget in @p bounds and lay out its children
+         * 
+         * A widget whose layout is still valid and whose size doesn't change
+         * is only moved; its children are not laid out again.
+         * 
+         * @param bounds Position and size given by the parent
+         */
+        void arrange(const Rect& bounds);
+        
+        /**
+         * @brief Mark this widget's size or children as changed
+         * 
+         * Flags the widget and its ancestors so that the next layout pass
+         * measures and arranges them again; untouched subtrees keep their
+         * cached layout. The pass runs right away from the top-level widget,
+         * unless a layout pass is already running or the change is made
+         * inside an update batch, which lays out once when it ends.
+         * 
+         * @example
+         * @code
+         * button->resize(200, 40);
+         * button->invalidateLayout();  // Let the enclosing Row make room
+         * @endcode
+         */
+        void invalidateLayout();
+        
+        /**
+         * @brief Check if the widget has to be measured or arranged again
+         */
+        bool needsLayout() const { return measureDirty_ || arrangeDirty_; }
+        
+        /**
+         * @brief Get the layout this widget was added to, if any
+         * @return Widget* Parent widget, or nullptr for top-level widgets
+         */
+        Widget* getParent() const { return parent_; }
+        
+        /**
+         * @brief Check what kind of widget this is without RTTI
+         * 
+         * @param capability One WidgetCapability bit
+         * @return true if the widget was constructed with that bit
+         */
+        bool hasCapability(WidgetCapability capability) const {
+            return (capabilities_ & static_cast<uint32_t>(capability)) != 0;
+        }
+        
+        /**
+         * @brief Get the ResponsiveWidget interface, if the widget implements it
+         * 
+         * Widgets that implement ResponsiveWidget override this to return
+         * themselves, which is all the widget manager needs to resize them.
+         */
+        virtual ResponsiveWidget* asResponsive() { return nullptr; }
+        
+        /**
+         * @brief Defer layout passes for all widgets until endLayoutBatch()
+         * 
+         * Widgets changed in the meantime are only flagged. The last
+         * endLayoutBatch() lays out each affected top-level widget once,
+         * however many changes were made. Batches nest. Prefer the
+         * LayoutBatch guard or WidgetManager::beginUpdate().
+         */
+        static void beginLayoutBatch();
+        
+        /**
+         * @brief Close a batch opened by beginLayoutBatch(), laying out when it's the last
+         */
+        static void endLayoutBatch();
+        
     protected:
+        /**
+         * @brief Compute the preferred size; called by measure() on a cache miss
+         * 
+         * The default keeps the widget's current size, which suits widgets
+         * sized by their config. Layouts override it to size themselves
+         * from their children.
+         */
+        virtual Size onMeasure(const Constraints& constraints) {
+            return constraints.constrain(Size(getWidth(), getHeight()));
+        }
+        
+        /**
+         * @brief Take on @p bounds; called by arrange() when layout is needed
+         * 
+         * The default moves and resizes the widget, skipping calls that
+         * wouldn't change anything.
+         */
+        virtual void onArrange(const Rect& bounds);
+        
+        /**
+         * @brief Run a pending layout pass, with this widget as the top level
+         * 
+         * The widget is measured without constraints, so it keeps the size
+         * it was given or, if it has none, takes the size of its content.
+         */
+        void layoutIfNeeded();
+        
+        /**
+         * @brief Defer layout passes for this widget's subtree until endUpdate()
+         * 
+         * Layouts expose these as part of their public interface. Changes
+         * elsewhere in the tree still lay out right away.
+         */
+        void beginUpdate() { updateDepth_++; }
+        
+        /**
+         * @brief Close an update opened by beginUpdate(), laying out when it's the last
+         */
+        void endUpdate();
+        
+        /**
+         * @brief Record @p parent as the layout that owns @p child
+         * 
+         * @param child Widget being added or removed
+         * @param parent New parent, or nullptr when the child is removed
+         */
+        static void adopt(Widget& child, Widget* parent) { child.parent_ = parent; }
+        
+
+        /**
+         * @brief Ask for a new frame after the widget's appearance changed
+         * 
+         * Needed for changes made outside input handling when the render loop
+         * runs in RedrawMode::OnDemand.
+         */
+        void invalidate() { requestRedraw(); }
+        
+        /**
+         * @brief Record what kind of widget this is; called from constructors
+         */
+        void addCapabilities(WidgetCapability capabilities) {
+            capabilities_ |= static_cast<uint32_t>(capabilities);
+        }
+        
         int x_ = 0;
         int y_ = 0;
         int width_ = 0;
         int height_ = 0;
+        
+    private:
+        Widget* parent_ = nullptr;       ///< Layout that arranges this widget
+        bool measureDirty_ = true;       ///< measured_ may be out of date
+        bool arrangeDirty_ = true;       ///< Children may need arranging again
+        Constraints measuredFor_[2];     ///< Constraints of the cached sizes
+        Size measured_[2];               ///< Results of the last two onMeasure() calls
+        int measuredCount_ = 0;          ///< Valid entries, newest first
+        int updateDepth_ = 0;            ///< Open beginUpdate() calls
+        uint32_t capabilities_ = 0;      ///< WidgetCapability bits
+        bool layoutQueued_ = false;      ///< Waiting for endLayoutBatch()
+        
+        void scheduleLayout();
+        
+        friend class LayoutBatch;
+    };
+    
+    /**
+     * @brief Downcast a widget by its capability bits instead of dynamic_cast
+     * 
+     * Works for widget classes that declare the bit they set as
+     * kCapability and name themselves as CapabilityClass, such as
+     * LayoutWidget, ExpandedWidget and SpacingWidget. Both are inherited,
+     * so a subclass like ColumnWidget would pass the Layout test without
+     * being a column; casting to a class that doesn't declare its own
+     * tag is a compile error.
+     * 
+     * @return The widget as a T, or nullptr if it isn't one
+     */
+    template <typename T>
+    T* widgetCast(Widget* widget) {
+        static_assert(std::is_same<typename T::CapabilityClass, T>::value,
+                      "widgetCast<T> needs a T that declares its own kCapability");
+        return widget && widget->hasCapability(T::kCapability) ? static_cast<T*>(widget) : nullptr;
+    }
+    
+    template <typename T>
+    const T* widgetCast(const Widget* widget) {
+        static_assert(std::is_same<typename T::CapabilityClass, T>::value,
+                      "widgetCast<T> needs a T that declares its own kCapability");
+        return widget && widget->hasCapability(T::kCapability) ? static_cast<const T*>(widget) : nullptr;
+    }
+    
+    /**
+     * @brief Scope guard that lays out once, when it goes out of scope
+     * 
+     * Without a widget it defers every layout pass, like
+     * WidgetManager::beginUpdate(); with one it defers only that widget's
+     * subtree, like LayoutWidget::beginUpdate().
+     * 
+     * @example Rebuilding a list from live data:
+     * @code
+     * {
+     *     LayoutBatch batch(*list);
+     *     list->clear();
+     *     for (const auto& item : items) {
+     *         list->add(Text(Point(0, 0), item.name, 2, Colors::White, false));
+     *     }
+     * }   // The list is laid out once, here
+     * @endcode
+     */
+    class LayoutBatch {
+    public:
+        LayoutBatch() : widget_(nullptr) { Widget::beginLayoutBatch(); }
+        explicit LayoutBatch(Widget& widget) : widget_(&widget) { widget.beginUpdate(); }
+        
+        ~LayoutBatch() {
+            if (widget_) {
+                widget_->endUpdate();
+            } else {
+                Widget::endLayoutBatch();
+            }
+        }
+        
+        LayoutBatch(const LayoutBatch&) = delete;
+        LayoutBatch& operator=(const LayoutBatch&) = delete;
+        
+    private:
+        Widget* widget_;  ///< Widget whose subtree is deferred; nullptr for all widgets
     };
 }
\ No newline at end of file
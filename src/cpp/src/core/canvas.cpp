@@ -1,28 +1,145 @@
 #include "../../include/fern/core/canvas.hpp"
+#include "../../include/fern/graphics/span.hpp"
+#include <algorithm>
 #include <cstring>
 
 namespace Fern {
     Canvas* globalCanvas = nullptr;
-    
+
     Canvas::Canvas(uint32_t* buffer, int width, int height)
-        : buffer_(buffer), width_(width), height_(height) {}
-    
+        : buffer_(buffer), width_(width), height_(height), clip_(0, 0, width, height) {
+        // A fresh canvas has never been presented, so all of it is new
+        damageAll();
+    }
+
     void Canvas::clear(uint32_t color) {
-        for (int i = 0; i < width_ * height_; ++i) {
-            buffer_[i] = color;
-        }
+        Span::fill(buffer_, width_ * height_, color);
+        damageAll();
     }
-    
+
     void Canvas::setPixel(int x, int y, uint32_t color) {
-        if (x >= 0 && x < width_ && y >= 0 && y < height_) {
+        if (x >= clip_.x && x < clip_.right() && y >= clip_.y && y < clip_.bottom()) {
             buffer_[y * width_ + x] = color;
+            addDamage(x, y, 1, 1);
         }
     }
-    
+
     uint32_t Canvas::getPixel(int x, int y) const {
         if (x >= 0 && x < width_ && y >= 0 && y < height_) {
             return buffer_[y * width_ + x];
         }
         return 0;
     }
-}
\ No newline at end of file
+
+    void Canvas::addDamage(int x, int y, int width, int height) {
+        Rect rect = Rect(x, y, width, height).intersected(clip_);
+        if (rect.isEmpty()) return;
+
+        // Fast path for runs of small writes inside the latest damage (setPixel loops)
+        if (!damage_.empty() && damage_.back().contains(rect)) return;
+
+        // Absorb every rectangle that overlaps, touches, or would cost little
+        // extra area to merge. The grown rectangle may reach others, so repeat
+        // until it settles.
+        bool merged = true;
+        while (merged) {
+            merged = false;
+            for (size_t i = 0; i < damage_.size(); ++i) {
+                const Rect& other = damage_[i];
+                if (other.contains(rect)) return;
+
+                Rect touching(other.x - 1, other.y - 1, other.width + 2, other.height + 2);
+                Rect combined = rect.united(other);
+                if (rect.intersects(touching) || combined.area() <= rect.area() + other.area()) {
+                    rect = combined;
+                    damage_[i] = damage_.back();
+                    damage_.pop_back();
+                    merged = true;
+                    break;
+                }
+            }
+        }
+
+        damage_.push_back(rect);
+
+        if (damage_.size() > kMaxDamageRects) {
+            Rect bounds;
+            for (const auto& r : damage_) {
+                bounds = bounds.united(r);
+            }
+            damage_.clear();
+            damage_.push_back(bounds);
+        }
+    }
+
+    void Canvas::trimDamage() {
+        size_t pixels = static_cast<size_t>(width_) * height_;
+        if (presented_.size() != pixels) {
+            // Nothing to compare with yet, so everything counts as changed
+            presented_.assign(buffer_, buffer_ + pixels);
+            return;
+        }
+
+        written_.swap(damage_);
+        damage_.clear();
+
+        // Damage is kept inside the clip; the comparison covers the whole canvas
+        Rect clip = clip_;
+        clip_ = Rect(0, 0, width_, height_);
+
+        for (const Rect& rect : written_) {
+            // Each run of changed rows becomes one rectangle as wide as its changes
+            int runTop = -1, runLeft = 0, runRight = 0;
+            for (int row = rect.y; row <= rect.bottom(); ++row) {
+                bool changed = false;
+                if (row < rect.bottom()) {
+                    size_t offset = static_cast<size_t>(row) * width_ + rect.x;
+                    const uint32_t* now = buffer_ + offset;
+                    uint32_t* before = presented_.data() + offset;
+                    if (std::memcmp(now, before, rect.width * sizeof(uint32_t)) != 0) {
+                        int left = 0;
+                        int right = rect.width - 1;
+                        while (now[left] == before[left]) ++left;
+                        while (now[right] == before[right]) --right;
+                        std::memcpy(before + left, now + left, (right - left + 1) * sizeof(uint32_t));
+
+                        if (runTop < 0) {
+                            runTop = row;
+                            runLeft = left;
+                            runRight = right;
+                        } else {
+                            runLeft = std::min(runLeft, left);
+                            runRight = std::max(runRight, right);
+                        }
+                        changed = true;
+                    }
+                }
+                if (!changed && runTop >= 0) {
+                    addDamage(rect.x + runLeft, runTop, runRight - runLeft + 1, row - runTop);
+                    runTop = -1;
+                }
+            }
+        }
+
+        written_.clear();
+        clip_ = clip;
+    }
+
+    void Canvas::pushClip(int x, int y, int width, int height) {
+        clipStack_.push_back(clip_);
+        clip_ = clip_.intersected(Rect(x, y, width, height));
+    }
+
+    void Canvas::popClip() {
+        if (clipStack_.empty()) return;
+        clip_ = clipStack_.back();
+        clipStack_.pop_back();
+    }
+
+    void Canvas::damageAll() {
+        damage_.clear();
+        if (width_ > 0 && height_ > 0) {
+            damage_.push_back(Rect(0, 0, width_, height_));
+        }
+    }
+}
@@ -6,6 +6,9 @@
 #ifdef __EMSCRIPTEN__
 #include <emscripten.h>
 #endif
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <iostream>
 
 namespace Fern {
@@ -19,6 +22,30 @@ namespace Fern {
     static int lastHeight = 600;
 
     static std::function<void(int, int)> windowResizeCallback = nullptr;
+    
+    using RedrawClock = std::chrono::steady_clock;
+    static RedrawMode redrawMode = RedrawMode::Continuous;
+    static std::atomic<bool> redrawRequested{true};
+    static bool redrawScheduled = false;
+    static RedrawClock::time_point redrawDeadline;
+    
+    // Point the canvas at the renderer's own buffer when it has one, so frames
+    // are presented without a copy; otherwise allocate one ourselves
+    static void attachCanvas(int width, int height) {
+        uint32_t* buffer = renderer->getPixelBuffer();
+        if (buffer) {
+            managedBuffer.reset();
+        } else {
+            managedBuffer.reset(new uint32_t[width * height]);
+            
+            // Initialize the new buffer to opaque black (ARGB format: 0xAARRGGBB)
+            std::fill_n(managedBuffer.get(), width * height, 0xFF000000);
+            buffer = managedBuffer.get();
+        }
+        
+        delete globalCanvas;
+        globalCanvas = new Canvas(buffer, width, height);
+    }
 
     int getWidth() {
         return lastWidth;
@@ -58,13 +85,10 @@ namespace Fern {
         lastHeight = height;
         
         renderer = createRenderer();
+        renderer->initialize(width, height);
         
-        managedBuffer.reset(new uint32_t[width * height]);
         usingManagedBuffer = true;
-        
-        globalCanvas = new Canvas(managedBuffer.get(), width, height);
-        
-        renderer->initialize(width, height);
+        attachCanvas(width, height);
         
         renderer->setMouseCallback([](int x, int y) {
             Input::updateMousePosition(x, y);
@@ -88,15 +112,8 @@ namespace Fern {
         
         renderer->setResizeCallback([](int width, int height) {
             if (usingManagedBuffer && (width != lastWidth || height != lastHeight)) {
-                // Create new buffer for new dimensions
-                managedBuffer.reset(new uint32_t[width * height]);
-                
-                // Initialize the new buffer to opaque black (ARGB format: 0xAARRGGBB)
-                std::fill_n(managedBuffer.get(), width * height, 0xFF000000);
-                
-                // Delete old canvas and create new one
-                delete globalCanvas;
-                globalCanvas = new Canvas(managedBuffer.get(), width, height);
+                // Recreate the canvas on a buffer of the new size
+                attachCanvas(width, height);
                 
                 lastWidth = width;
                 lastHeight = height;
@@ -134,6 +151,48 @@ namespace Fern {
         });
     }
     
+    void setRedrawMode(RedrawMode mode) {
+        redrawMode = mode;
+        requestRedraw();
+    }
+    
+    void requestRedraw() {
+        // Only the first request since the last frame has to wake the loop
+        if (!redrawRequested.exchange(true) && renderer && redrawMode == RedrawMode::OnDemand) {
+            renderer->wake();
+        }
+    }
+    
+    void scheduleRedraw(int milliseconds) {
+        auto deadline = RedrawClock::now() + std::chrono::milliseconds(std::max(0, milliseconds));
+        if (!redrawScheduled || deadline < redrawDeadline) {
+            redrawDeadline = deadline;
+            redrawScheduled = true;
+        }
+    }
+    
+    // Sleep until the next frame is due in OnDemand mode
+    static void waitForFrame() {
+        while (!redrawRequested.exchange(false)) {
+            int timeout = -1;
+            if (redrawScheduled) {
+                auto remaining = std::chrono::ceil<std::chrono::milliseconds>(
+                    redrawDeadline - RedrawClock::now()).count();
+                if (remaining <= 0) {
+                    redrawScheduled = false;
+                    return;
+                }
+                timeout = static_cast<int>(remaining);
+            }
+            
+            if (renderer->waitEvents(timeout)) {
+                // Signal handlers run after the draw callback, so draw once more
+                redrawRequested = true;
+                return;
+            }
+        }
+    }
+    
     void startRenderLoop() {
 #ifdef __EMSCRIPTEN__
         emscripten_set_main_loop([]() {
@@ -146,12 +205,17 @@ namespace Fern {
             WidgetManager::getInstance().updateAll(Input::getState());
             WidgetManager::getInstance().renderAll();
             
-            renderer->present(globalCanvas->getBuffer(), lastWidth, lastHeight);
+            globalCanvas->trimDamage();
+            renderer->present(globalCanvas->getBuffer(), lastWidth, lastHeight, globalCanvas->getDamage());
+            globalCanvas->clearDamage();
             
             Input::resetEvents();
         }, 0, 1);
 #else
         while (!renderer->shouldClose()) {
+            if (redrawMode == RedrawMode::OnDemand) {
+                waitForFrame();
+            }
             renderer->pollEvents();
             
             if (drawCallback) {
@@ -161,7 +225,9 @@ namespace Fern {
             WidgetManager::getInstance().updateAll(Input::getState());
             WidgetManager::getInstance().renderAll();
             
-            renderer->present(globalCanvas->getBuffer(), lastWidth, lastHeight);
+            globalCanvas->trimDamage();
+            renderer->present(globalCanvas->getBuffer(), lastWidth, lastHeight, globalCanvas->getDamage());
+            globalCanvas->clearDamage();
             Input::resetEvents();
         }
         
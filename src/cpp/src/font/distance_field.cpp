@@ -0,0 +1,87 @@
+#include "../../include/fern/font/distance_field.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace Fern {
+namespace DistanceField {
+
+namespace {
+
+const double kInfinity = 1e20;
+
+// One dimension of the Felzenszwalb-Huttenlocher squared distance
+// transform: the lower envelope of the parabolas rooted at each sample.
+void transform1D(double* grid, int offset, int stride, int length,
+                 std::vector<double>& f, std::vector<int>& v, std::vector<double>& z) {
+    v[0] = 0;
+    z[0] = -kInfinity;
+    z[1] = kInfinity;
+    f[0] = grid[offset];
+
+    for (int q = 1, k = 0; q < length; q++) {
+        f[q] = grid[offset + q * stride];
+        double s;
+        do {
+            int r = v[k];
+            s = (f[q] - f[r] + static_cast<double>(q) * q - static_cast<double>(r) * r) / (q - r) / 2.0;
+        } while (s <= z[k] && --k > -1);
+        k++;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = kInfinity;
+    }
+
+    for (int q = 0, k = 0; q < length; q++) {
+        while (z[k + 1] < q) k++;
+        int r = v[k];
+        grid[offset + q * stride] = f[r] + static_cast<double>(q - r) * (q - r);
+    }
+}
+
+void transform2D(std::vector<double>& grid, int width, int height,
+                 std::vector<double>& f, std::vector<int>& v, std::vector<double>& z) {
+    for (int x = 0; x < width; x++) transform1D(grid.data(), x, width, height, f, v, z);
+    for (int y = 0; y < height; y++) transform1D(grid.data(), y * width, 1, width, f, v, z);
+}
+
+}
+
+void fromCoverage(const uint8_t* coverage, int width, int height,
+                  float radius, uint8_t* field) {
+    size_t count = static_cast<size_t>(width) * height;
+    std::vector<double> outer(count), inner(count);
+
+    // Seed both grids: fully covered pixels are inside, empty ones outside,
+    // and partial ones sit on the edge at a distance given by their coverage
+    for (size_t i = 0; i < count; i++) {
+        double a = coverage[i] / 255.0;
+        if (a >= 1.0) {
+            outer[i] = 0.0;
+            inner[i] = kInfinity;
+        } else if (a <= 0.0) {
+            outer[i] = kInfinity;
+            inner[i] = 0.0;
+        } else {
+            double out = std::max(0.0, 0.5 - a);
+            double in = std::max(0.0, a - 0.5);
+            outer[i] = out * out;
+            inner[i] = in * in;
+        }
+    }
+
+    int longest = std::max(width, height);
+    std::vector<double> f(longest), z(longest + 1);
+    std::vector<int> v(longest);
+    transform2D(outer, width, height, f, v, z);
+    transform2D(inner, width, height, f, v, z);
+
+    for (size_t i = 0; i < count; i++) {
+        double distance = std::sqrt(outer[i]) - std::sqrt(inner[i]);
+        double value = kEdgeValue - 255.0 * distance / radius;
+        field[i] = static_cast<uint8_t>(std::min(255.0, std::max(0.0, std::round(value))));
+    }
+}
+
+}
+}
@@ -10,6 +10,10 @@ namespace Fern {
         return TTFFontManager::getInstance().loadFont(name, fontPath);
     }
     
+    bool Font::loadTTFFont(const std::string& name, const uint8_t* data, size_t size) {
+        return TTFFontManager::getInstance().loadFont(name, data, size);
+    }
+    
     void Font::setDefaultTTFFont(const std::string& name) {
         TTFFontManager::getInstance().setDefaultFont(name);
     }
@@ -0,0 +1,48 @@
+#include "../../include/fern/font/glyph_atlas.hpp"
+#include <algorithm>
+
+namespace Fern {
+
+GlyphAtlas::GlyphAtlas(int width)
+    : width_(std::max(1, width)), height_(0), nextShelfY_(0) {
+}
+
+bool GlyphAtlas::allocate(int width, int height, int& x, int& y) {
+    if (width > width_ || width <= 0 || height <= 0) return false;
+
+    // Tightest shelf with room left; a much taller one would waste its height
+    Shelf* best = nullptr;
+    for (Shelf& shelf : shelves_) {
+        if (shelf.height < height || shelf.used + width > width_) continue;
+        if (shelf.height > height + height / 2) continue;
+        if (!best || shelf.height < best->height) {
+            best = &shelf;
+        }
+    }
+
+    if (!best) {
+        if (nextShelfY_ + height > height_) {
+            // Grow by doubling; rows keep their place since the width is fixed
+            height_ = std::max(height_ * 2, nextShelfY_ + height);
+            pixels_.resize(static_cast<size_t>(width_) * height_, 0);
+        }
+        shelves_.push_back({nextShelfY_, height, 0});
+        nextShelfY_ += height;
+        best = &shelves_.back();
+    }
+
+    x = best->used;
+    y = best->y;
+    best->used += width;
+    return true;
+}
+
+void GlyphAtlas::clear() {
+    pixels_.clear();
+    pixels_.shrink_to_fit();
+    shelves_.clear();
+    height_ = 0;
+    nextShelfY_ = 0;
+}
+
+}
@@ -0,0 +1,138 @@
+#include "../../include/fern/font/glyph_rasterizer.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace Fern {
+
+void GlyphRasterizer::reset(int width, int height) {
+    width_ = std::max(0, width);
+    height_ = std::max(0, height);
+    // An edge on the right border spills one cell past its row
+    area_.assign(static_cast<size_t>(width_) * height_ + 2, 0.0f);
+    startX_ = startY_ = penX_ = penY_ = 0;
+}
+
+void GlyphRasterizer::moveTo(float x, float y) {
+    close();
+    startX_ = penX_ = x;
+    startY_ = penY_ = y;
+}
+
+void GlyphRasterizer::lineTo(float x, float y) {
+    addLine(penX_, penY_, x, y);
+    penX_ = x;
+    penY_ = y;
+}
+
+void GlyphRasterizer::quadTo(float controlX, float controlY, float x, float y) {
+    // How far the control point bends the curve off its chord decides the
+    // number of segments; flat curves become a single line
+    float devX = penX_ - 2.0f * controlX + x;
+    float devY = penY_ - 2.0f * controlY + y;
+    float devSq = devX * devX + devY * devY;
+    if (devSq < 0.333f) {
+        lineTo(x, y);
+        return;
+    }
+
+    int segments = 1 + static_cast<int>(std::floor(std::sqrt(std::sqrt(3.0f * devSq))));
+    float x0 = penX_, y0 = penY_;
+    float step = 1.0f / segments;
+    for (int i = 1; i < segments; i++) {
+        float t = i * step;
+        float mt = 1.0f - t;
+        lineTo(mt * mt * x0 + 2.0f * mt * t * controlX + t * t * x,
+               mt * mt * y0 + 2.0f * mt * t * controlY + t * t * y);
+    }
+    lineTo(x, y);
+}
+
+void GlyphRasterizer::close() {
+    if (penX_ != startX_ || penY_ != startY_) {
+        lineTo(startX_, startY_);
+    }
+}
+
+void GlyphRasterizer::addLine(float x0, float y0, float x1, float y1) {
+    if (y0 == y1) return; // Horizontal edges cover no area
+
+    // Walk downwards; the direction becomes the sign of the coverage
+    float dir = 1.0f;
+    if (y0 > y1) {
+        std::swap(x0, x1);
+        std::swap(y0, y1);
+        dir = -1.0f;
+    }
+
+    // Keep x inside the bitmap so every write lands in the buffer
+    float maxX = static_cast<float>(width_);
+    x0 = std::min(std::max(x0, 0.0f), maxX);
+    x1 = std::min(std::max(x1, 0.0f), maxX);
+
+    float dxdy = (x1 - x0) / (y1 - y0);
+    float x = x0;
+    if (y0 < 0.0f) x = std::min(std::max(x - y0 * dxdy, 0.0f), maxX);
+
+    int yStart = std::max(0, static_cast<int>(y0));
+    int yEnd = std::min(height_, static_cast<int>(std::ceil(y1)));
+
+    for (int y = yStart; y < yEnd; y++) {
+        float* row = area_.data() + static_cast<size_t>(y) * width_;
+        float dy = std::min(static_cast<float>(y + 1), y1) - std::max(static_cast<float>(y), y0);
+        // Steep-to-flat edges can step a hair outside through rounding
+        float xNext = std::min(std::max(x + dxdy * dy, 0.0f), maxX);
+        float d = dy * dir;
+
+        float left = std::min(x, xNext);
+        float right = std::max(x, xNext);
+        float leftFloor = std::floor(left);
+        int leftCell = static_cast<int>(leftFloor);
+        float rightCeil = std::ceil(right);
+        int rightCell = static_cast<int>(rightCeil);
+
+        if (rightCell <= leftCell + 1) {
+            // Edge stays within one pixel column: split by its mean x
+            float mid = 0.5f * (x + xNext) - leftFloor;
+            row[leftCell] += d - d * mid;
+            row[leftCell + 1] += d * mid;
+        } else {
+            // Edge crosses several columns: a triangle in the first, a
+            // constant ramp through the middle, the rest in the last
+            float invWidth = 1.0f / (right - left);
+            float leftFrac = left - leftFloor;
+            float firstArea = 0.5f * invWidth * (1.0f - leftFrac) * (1.0f - leftFrac);
+            float rightFrac = right - rightCeil + 1.0f;
+            float lastArea = 0.5f * invWidth * rightFrac * rightFrac;
+
+            row[leftCell] += d * firstArea;
+            if (rightCell == leftCell + 2) {
+                row[leftCell + 1] += d * (1.0f - firstArea - lastArea);
+            } else {
+                float secondArea = invWidth * (1.5f - leftFrac);
+                row[leftCell + 1] += d * (secondArea - firstArea);
+                for (int cell = leftCell + 2; cell < rightCell - 1; cell++) {
+                    row[cell] += d * invWidth;
+                }
+                float coveredArea = secondArea + (rightCell - leftCell - 3) * invWidth;
+                row[rightCell - 1] += d * (1.0f - coveredArea - lastArea);
+            }
+            row[rightCell] += d * lastArea;
+        }
+
+        x = xNext;
+    }
+}
+
+void GlyphRasterizer::accumulate(uint8_t* coverage) const {
+    // Closed contours sum to zero across each row, so one running total
+    // over the whole buffer is the signed coverage of every pixel
+    size_t count = static_cast<size_t>(width_) * height_;
+    float sum = 0.0f;
+    for (size_t i = 0; i < count; i++) {
+        sum += area_[i];
+        float alpha = std::min(std::fabs(sum), 1.0f);
+        coverage[i] = static_cast<uint8_t>(alpha * 255.0f + 0.5f);
+    }
+}
+
+}
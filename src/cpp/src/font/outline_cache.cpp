@@ -0,0 +1,135 @@
+#include "../../include/fern/font/outline_cache.hpp"
+
+namespace Fern {
+
+const OutlineCache::Outline* OutlineCache::get(TTFReader& reader, uint16_t glyphIndex) {
+    auto it = outlines_.find(glyphIndex);
+    if (it != outlines_.end()) {
+        hits_++;
+        return it->second.drawable ? &it->second.outline : nullptr;
+    }
+    misses_++;
+
+    // Glyphs that fail to read are remembered too, so they are not retried
+    Entry entry;
+    if (reader.readGlyphByIndex(glyphIndex, scratch_)) {
+        decode(scratch_, entry.outline);
+        entry.drawable = entry.outline.verbCount > 0;
+    }
+
+    Entry& stored = outlines_.emplace(glyphIndex, entry).first->second;
+    return stored.drawable ? &stored.outline : nullptr;
+}
+
+void OutlineCache::decode(const SimpleGlyph& glyph, Outline& outline) {
+    outline.firstVerb = static_cast<uint32_t>(verbs_.size());
+    outline.firstPoint = static_cast<uint32_t>(points_.size() / 2);
+    outline.xMin = glyph.header.xMin;
+    outline.yMin = glyph.header.yMin;
+    outline.xMax = glyph.header.xMax;
+    outline.yMax = glyph.header.yMax;
+
+    size_t startPt = 0;
+    for (uint16_t endPt : glyph.endPtsOfContours) {
+        if (endPt < startPt || endPt >= glyph.points.size()) break;
+        size_t count = endPt - startPt + 1;
+        const TTFPoint* points = &glyph.points[startPt];
+        startPt = endPt + 1;
+        if (count < 2) continue;
+
+        // Start on an on-curve point; if there is none, at the implied
+        // midpoint between the first two control points
+        size_t first = 0;
+        while (first < count && !points[first].onCurve) first++;
+
+        float startX, startY;
+        if (first < count) {
+            startX = points[first].x;
+            startY = points[first].y;
+        } else {
+            first = 0;
+            startX = (points[0].x + points[1].x) * 0.5f;
+            startY = (points[0].y + points[1].y) * 0.5f;
+        }
+        verbs_.push_back(MoveTo);
+        addPoint(startX, startY);
+
+        // Walk once around the contour from there
+        bool hasControl = false;
+        float controlX = 0, controlY = 0;
+        for (size_t n = 1; n <= count; n++) {
+            const TTFPoint& pt = points[(first + n) % count];
+
+            if (pt.onCurve) {
+                if (hasControl) {
+                    verbs_.push_back(QuadTo);
+                    addPoint(controlX, controlY);
+                } else {
+                    verbs_.push_back(LineTo);
+                }
+                addPoint(pt.x, pt.y);
+                hasControl = false;
+            } else {
+                if (hasControl) {
+                    // Two control points in a row imply an on-curve point between them
+                    verbs_.push_back(QuadTo);
+                    addPoint(controlX, controlY);
+                    addPoint((controlX + pt.x) * 0.5f, (controlY + pt.y) * 0.5f);
+                }
+                controlX = pt.x;
+                controlY = pt.y;
+                hasControl = true;
+            }
+        }
+
+        // Back to the start, which may itself follow a control point
+        if (hasControl) {
+            verbs_.push_back(QuadTo);
+            addPoint(controlX, controlY);
+            addPoint(startX, startY);
+        }
+    }
+
+    outline.verbCount = static_cast<uint32_t>(verbs_.size()) - outline.firstVerb;
+}
+
+void OutlineCache::trace(const Outline& outline, GlyphRasterizer& rasterizer,
+                         float scale, float originX, float originY) const {
+    const float* point = &points_[outline.firstPoint * 2];
+    auto pixelX = [&](float x) { return x * scale - originX; };
+    auto pixelY = [&](float y) { return originY - y * scale; };
+
+    for (uint32_t i = 0; i < outline.verbCount; i++) {
+        switch (verbs_[outline.firstVerb + i]) {
+            case MoveTo:
+                rasterizer.moveTo(pixelX(point[0]), pixelY(point[1]));
+                point += 2;
+                break;
+            case LineTo:
+                rasterizer.lineTo(pixelX(point[0]), pixelY(point[1]));
+                point += 2;
+                break;
+            case QuadTo:
+                rasterizer.quadTo(pixelX(point[0]), pixelY(point[1]),
+                                  pixelX(point[2]), pixelY(point[3]));
+                point += 4;
+                break;
+        }
+    }
+    rasterizer.close();
+}
+
+size_t OutlineCache::getByteSize() const {
+    return verbs_.capacity() + points_.capacity() * sizeof(float) +
+           outlines_.size() * (sizeof(uint16_t) + sizeof(Entry));
+}
+
+void OutlineCache::clear() {
+    outlines_.clear();
+    verbs_.clear();
+    verbs_.shrink_to_fit();
+    points_.clear();
+    points_.shrink_to_fit();
+}
+
+}
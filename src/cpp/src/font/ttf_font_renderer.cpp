@@ -1,4 +1,6 @@
 #include "../../include/fern/font/ttf_font_renderer.hpp"
+#include "../../include/fern/font/distance_field.hpp"
+#include "../../include/fern/graphics/span.hpp"
 #include <algorithm>
 #include <cmath>
 #ifdef __EMSCRIPTEN__
@@ -7,6 +9,26 @@
 
 namespace Fern {
 
+namespace {
+
+// Lookup cost of one cached glyph on top of its atlas pixels: the handle,
+// its key and the hash node around them
+constexpr size_t kGlyphEntryBytes = sizeof(TTFFontRenderer::GlyphHandle) + sizeof(uint32_t) + 2 * sizeof(void*);
+
+// Shared by all renderers so that use times compare across fonts
+uint64_t useClock = 0;
+
+}
+
+TTFFontRenderer::CacheStats& TTFFontRenderer::CacheStats::operator+=(const CacheStats& other) {
+    entries += other.entries;
+    bytes += other.bytes;
+    hits += other.hits;
+    misses += other.misses;
+    evictions += other.evictions;
+    return *this;
+}
+
 TTFFontRenderer::TTFFontRenderer(const std::string& fontPath) {
     ttfReader_ = std::make_unique<TTFReader>();
     
@@ -14,6 +36,20 @@ TTFFontRenderer::TTFFontRenderer(const std::string& fontPath) {
         throw std::runtime_error("Failed to open font: " + fontPath);
     }
     
+    loadTables();
+}
+
+TTFFontRenderer::TTFFontRenderer(const uint8_t* data, size_t size) {
+    ttfReader_ = std::make_unique<TTFReader>();
+    
+    if (!ttfReader_->openFontData(data, size)) {
+        throw std::runtime_error("Failed to open font from memory");
+    }
+    
+    loadTables();
+}
+
+void TTFFontRenderer::loadTables() {
     // Load required tables
     if (!ttfReader_->loadHeadTable()) {
 
@@ -27,195 +63,432 @@ TTFFontRenderer::TTFFontRenderer(const std::string& fontPath) {
         throw std::runtime_error("Failed to load loca table");
     }
     
+    // Without them measurements fall back to em-based defaults
+    ttfReader_->loadMetricsTables();
+    glyphIndexPages_.assign(256, std::vector<int32_t>());
 }
 
-TTFFontRenderer::RasterizedGlyph TTFFontRenderer::rasterizeGlyph(char character, int fontSize) {
-    int cacheKey = getCacheKey(character, fontSize);
-    
-    // Check cache first
-    auto it = glyphCache_.find(cacheKey);
-    if (it != glyphCache_.end()) {
-        return it->second;
+uint16_t TTFFontRenderer::getGlyphIndex(uint32_t codepoint) {
+    if (codepoint > 0xFFFF) {
+        return ttfReader_->getGlyphIndex(codepoint);
     }
     
-    
-    // Get glyph index for character
-    uint16_t glyphIndex = ttfReader_->getGlyphIndex(static_cast<uint32_t>(character));
-    
-    
-    // Read glyph data
-    SimpleGlyph glyph;
-    if (!ttfReader_->readGlyphByIndex(glyphIndex, glyph)) {
-        // Return fallback glyph for missing characters
-        RasterizedGlyph empty;
-        empty.width = fontSize / 2;
-        empty.height = fontSize;
-        empty.advance = fontSize / 2;
-        empty.bearingX = 0;
-        empty.bearingY = fontSize;
-        
-        // Create a simple fallback bitmap (small rectangle)
-        empty.bitmap.resize(empty.width * empty.height, 0);
-        for (int y = 2; y < empty.height - 2; y++) {
-            for (int x = 2; x < empty.width - 2; x++) {
-                empty.bitmap[y * empty.width + x] = 128;
+    std::vector<int32_t>& page = glyphIndexPages_[codepoint >> 8];
+    if (page.empty()) page.assign(256, -1);
+    int32_t& index = page[codepoint & 0xFF];
+    if (index < 0) {
+        index = ttfReader_->getGlyphIndex(codepoint);
+    }
+    return static_cast<uint16_t>(index);
+}
+
+TTFFontRenderer::GlyphSet& TTFFontRenderer::getGlyphSet(int fontSize) {
+    auto it = glyphSets_.find(fontSize);
+    if (it == glyphSets_.end()) {
+        // Room for at least eight glyphs per shelf
+        int glyphSize = fontSize == kFieldSetKey ? kFieldSize + 2 * kFieldPadding : fontSize;
+        int atlasWidth = 256;
+        while (atlasWidth < (glyphSize + 4) * 8) atlasWidth *= 2;
+        it = glyphSets_.emplace(fontSize, GlyphSet(atlasWidth)).first;
+    }
+    it->second.lastUse = ++useClock;
+    return it->second;
+}
+
+void TTFFontRenderer::updateCacheBytes(GlyphSet& set) {
+    size_t bytes = set.atlas.getByteSize() + set.glyphs.size() * kGlyphEntryBytes;
+    cacheBytes_ = cacheBytes_ - set.bytes + bytes;
+    set.bytes = bytes;
+}
+
+void TTFFontRenderer::trimCache(GlyphSet* adding) {
+    // Drop whole sizes, least recently used first, but never the set a
+    // glyph is being added to: its caller still holds it, and starting it
+    // over would rasterize the same string again on every draw
+    while (cacheBudget_ > 0 && cacheBytes_ > cacheBudget_) {
+        auto oldest = glyphSets_.end();
+        for (auto it = glyphSets_.begin(); it != glyphSets_.end(); ++it) {
+            if (&it->second == adding) continue;
+            if (oldest == glyphSets_.end() || it->second.lastUse < oldest->second.lastUse) {
+                oldest = it;
             }
         }
+        if (oldest == glyphSets_.end()) break;
         
-        glyphCache_[cacheKey] = empty;
-        return empty;
+        cacheBytes_ -= oldest->second.bytes;
+        cacheCounters_.evictions += oldest->second.glyphs.size();
+        glyphSets_.erase(oldest);
+        cacheGeneration_++;
     }
     
-    // Rasterize the glyph
-    RasterizedGlyph rasterized;
-    rasterizeGlyphOutline(glyph, fontSize, rasterized);
-    
-    // Cache the result
-    glyphCache_[cacheKey] = rasterized;
-    
-    return rasterized;
+    // Then the budget shared with the other fonts, which may evict from
+    // this one too; widgets keep their font pointers, so this is the one
+    // place it is sure to be checked
+    adding_ = adding;
+    TTFFontManager::getInstance().trimCaches();
+    adding_ = nullptr;
 }
 
-void TTFFontRenderer::rasterizeGlyphOutline(const SimpleGlyph& glyph, int fontSize, RasterizedGlyph& output) {
-    float scale = static_cast<float>(fontSize) / static_cast<float>(ttfReader_->getUnitsPerEm());
-    
-    int glyphWidth = glyph.header.xMax - glyph.header.xMin;
-    int glyphHeight = glyph.header.yMax - glyph.header.yMin;
+uint64_t TTFFontRenderer::getOldestUse() const {
+    uint64_t oldest = ~uint64_t(0);
+    for (const auto& set : glyphSets_) {
+        if (&set.second == adding_) continue;
+        oldest = std::min(oldest, set.second.lastUse);
+    }
+    return oldest;
+}
+
+bool TTFFontRenderer::evictOldest() {
+    auto oldest = glyphSets_.end();
+    for (auto it = glyphSets_.begin(); it != glyphSets_.end(); ++it) {
+        if (&it->second == adding_) continue;
+        if (oldest == glyphSets_.end() || it->second.lastUse < oldest->second.lastUse) oldest = it;
+    }
+    if (oldest == glyphSets_.end()) return false;
     
+    cacheBytes_ -= oldest->second.bytes;
+    cacheCounters_.evictions += oldest->second.glyphs.size();
+    glyphSets_.erase(oldest);
+    cacheGeneration_++;
+    return true;
+}
+
+void TTFFontRenderer::clearCache() {
+    glyphSets_.clear();
+    cacheBytes_ = 0;
+    cacheGeneration_++;
+}
 
-    int scaledWidth = std::max(2, static_cast<int>(glyphWidth * scale));
-    int scaledHeight = std::max(2, static_cast<int>(glyphHeight * scale)); 
+const TTFFontRenderer::GlyphHandle& TTFFontRenderer::getGlyph(uint32_t codepoint, int fontSize) {
+    // Size 0 names the distance field set
+    fontSize = std::max(1, fontSize);
+    return getGlyph(getGlyphSet(fontSize), codepoint, fontSize);
+}
+
+const TTFFontRenderer::GlyphHandle& TTFFontRenderer::getGlyph(GlyphSet& set, uint32_t codepoint, int fontSize) {
+    // Check cache first
+    auto it = set.glyphs.find(codepoint);
+    if (it != set.glyphs.end()) {
+        cacheCounters_.hits++;
+        return it->second;
+    }
+    cacheCounters_.misses++;
+    trimCache(&set);
     
-    output.width = scaledWidth + 4;
-    output.height = scaledHeight + 4;
-    output.bearingX = static_cast<int>(glyph.header.xMin * scale);
-    output.bearingY = static_cast<int>(glyph.header.yMax * scale); // Distance from baseline to top of glyph
-    output.advance = std::max(1, static_cast<int>(glyphWidth * scale));
+    // Get glyph index for character
+    uint16_t glyphIndex = getGlyphIndex(codepoint);
+    
+    // Outlines are shared by all sizes; missing characters get a placeholder box
+    const OutlineCache::Outline* outline = outlines_.get(*ttfReader_, glyphIndex);
+    if (outline) {
+        rasterizeGlyphOutline(*outline, fontSize, scratch_);
+    } else {
+        rasterizeFallback(fontSize, scratch_);
+    }
     
-    // Create bitmap
-    output.bitmap.resize(output.width * output.height, 0);
+    GlyphHandle handle = packGlyph(set, scratch_);
+    handle.advance = scaled(ttfReader_->getAdvanceWidth(glyphIndex), fontSize);
+    return addGlyph(set, codepoint, handle);
+}
+
+const TTFFontRenderer::GlyphHandle& TTFFontRenderer::addGlyph(GlyphSet& set, uint32_t codepoint, const GlyphHandle& handle) {
+    const GlyphHandle& stored = set.glyphs.emplace(codepoint, handle).first->second;
+    updateCacheBytes(set);
+    trimCache(&set);
+    return stored;
+}
+
+const TTFFontRenderer::GlyphHandle& TTFFontRenderer::getDistanceField(GlyphSet& set, uint32_t codepoint) {
+    auto it = set.glyphs.find(codepoint);
+    if (it != set.glyphs.end()) {
+        cacheCounters_.hits++;
+        return it->second;
+    }
+    cacheCounters_.misses++;
+    trimCache(&set);
+    
+    // Rasterize once at the reference size, with room for the outside of
+    // the field, then turn the coverage into distances in place
+    uint16_t glyphIndex = getGlyphIndex(codepoint);
+    const OutlineCache::Outline* outline = outlines_.get(*ttfReader_, glyphIndex);
+    if (outline) {
+        rasterizeGlyphOutline(*outline, kFieldSize, scratch_, kFieldPadding);
+    } else {
+        rasterizeFallback(kFieldSize, scratch_);
+    }
+    DistanceField::fromCoverage(scratch_.bitmap.data(), scratch_.width, scratch_.height,
+                                static_cast<float>(kFieldRadius), scratch_.bitmap.data());
     
-    // If no points, create fallback
-    if (glyph.points.empty()) {
-        // Create a simple filled rectangle as fallback
-        for (int y = 1; y < output.height - 1; y++) {
-            for (int x = 1; x < output.width - 1; x++) {
-                output.bitmap[y * output.width + x] = 255;
-            }
+    GlyphHandle handle = packGlyph(set, scratch_);
+    handle.advance = scaled(ttfReader_->getAdvanceWidth(glyphIndex), kFieldSize);
+    return addGlyph(set, codepoint, handle);
+}
+
+TTFFontRenderer::GlyphHandle TTFFontRenderer::packGlyph(GlyphSet& set, const RasterizedGlyph& glyph) {
+    GlyphHandle handle;
+    handle.bearingX = glyph.bearingX;
+    handle.bearingY = glyph.bearingY;
+    if (set.atlas.allocate(glyph.width, glyph.height, handle.atlasX, handle.atlasY)) {
+        handle.atlas = &set.atlas;
+        handle.width = glyph.width;
+        handle.height = glyph.height;
+        for (int row = 0; row < handle.height; row++) {
+            std::copy_n(&glyph.bitmap[row * glyph.width], glyph.width,
+                        set.atlas.row(handle.atlasY + row) + handle.atlasX);
+        }
+    }
+    return handle;
+}
+
+void TTFFontRenderer::rasterizeFallback(int fontSize, RasterizedGlyph& output) {
+    output.width = fontSize / 2;
+    output.height = fontSize;
+    output.bearingX = 0;
+    output.bearingY = fontSize;
+    
+    // Create a simple fallback bitmap (small rectangle)
+    output.bitmap.assign(output.width * output.height, 0);
+    for (int y = 2; y < output.height - 2; y++) {
+        for (int x = 2; x < output.width - 2; x++) {
+            output.bitmap[y * output.width + x] = 128;
         }
-        return;
     }
+}
+
+size_t TTFFontRenderer::getCacheSize() const {
+    size_t count = 0;
+    for (const auto& set : glyphSets_) {
+        count += set.second.glyphs.size();
+    }
+    return count;
+}
+
+TTFFontRenderer::CacheStats TTFFontRenderer::getCacheStats() const {
+    CacheStats stats = cacheCounters_;
+    stats.entries = getCacheSize();
+    stats.bytes = cacheBytes_;
+    return stats;
+}
+
+void TTFFontRenderer::rasterizeGlyphOutline(const OutlineCache::Outline& outline, int fontSize,
+                                            RasterizedGlyph& output, int padding) {
+    float scale = static_cast<float>(fontSize) / static_cast<float>(ttfReader_->getUnitsPerEm());
     
-    rasterizeGlyphContours(glyph, output, scale);
+    // Smallest pixel box around the scaled outline, plus any padding
+    int left = static_cast<int>(std::floor(outline.xMin * scale)) - padding;
+    int right = static_cast<int>(std::ceil(outline.xMax * scale)) + padding;
+    int top = static_cast<int>(std::ceil(outline.yMax * scale)) + padding;
+    int bottom = static_cast<int>(std::floor(outline.yMin * scale)) - padding;
     
-    int pixelCount = 0;
-    for (uint8_t pixel : output.bitmap) {
-        if (pixel > 0) pixelCount++;
-    }
+    output.width = std::max(1, right - left);
+    output.height = std::max(1, top - bottom);
+    output.bearingX = left;
+    output.bearingY = top; // Distance from baseline to top of glyph
     
-
+    // Create bitmap, reusing the scratch allocation
+    output.bitmap.assign(output.width * output.height, 0);
+    
+    rasterizer_.reset(output.width, output.height);
+    outlines_.trace(outline, rasterizer_, scale, static_cast<float>(left), static_cast<float>(top));
+    rasterizer_.accumulate(output.bitmap.data());
 }
 
 void TTFFontRenderer::renderText(Canvas* canvas, const std::string& text, 
     int x, int y, int fontSize, uint32_t color) {
-    int currentX = x;
+    layoutText(text, fontSize, scratchRun_);
+    drawRun(canvas, scratchRun_, x, y, color);
+}
+
+void TTFFontRenderer::layoutText(const std::string& text, int fontSize, GlyphRun& run) {
+    run.glyphs.clear();
+    run.width = 0;
+    run.fontSize = fontSize;
+    run.mode = glyphMode_;
+    if (fontSize <= 0) {
+        run.generation = cacheGeneration_;
+        return;
+    }
     
-    for (char c : text) {
-        if (c == ' ') {
-            currentX += fontSize / 2;
-            continue;
-        }
-        
-        RasterizedGlyph glyph = rasterizeGlyph(c, fontSize);
-     
-        // Render glyph bitmap to canvas
-        int pixelsRendered = 0;
-        for (int gy = 0; gy < glyph.height; gy++) {
-            for (int gx = 0; gx < glyph.width; gx++) {
-                uint8_t alpha = glyph.bitmap[gy * glyph.width + gx];
-                if (alpha > 0) {
-                    int px = currentX + gx + glyph.bearingX;
-                    int py = y - glyph.bearingY + gy;
-                    
-                    if (px >= 0 && px < canvas->getWidth() && 
-                        py >= 0 && py < canvas->getHeight()) {
-                        
-                        // Simple alpha blending
-                        if (alpha == 255) {
-                            canvas->setPixel(px, py, color);
-                        } else {
-                            uint32_t existing = canvas->getPixel(px, py);
-                            uint32_t blended = blendPixel(existing, color, alpha);
-                            canvas->setPixel(px, py, blended);
-                        }
-                        pixelsRendered++;
-                    }
-                }
-            }
-        }
+    // One set serves the whole string; eviction spares the set in use
+    bool useFields = glyphMode_ == GlyphMode::DistanceField;
+    GlyphSet& glyphs = getGlyphSet(useFields ? kFieldSetKey : fontSize);
+    float scale = getScaleFactor(fontSize);
+    
+    // The pen moves in font units and is rounded per glyph, so the text
+    // ends exactly where getTextWidth() says
+    int32_t pen = 0;
+    uint16_t previous = 0;
+    
+    for (size_t i = 0; i < text.size();) {
+        bool first = i == 0;
+        uint32_t codepoint = Utf8::decode(text, i);
+        uint16_t glyphIndex = getGlyphIndex(codepoint);
+        if (!first) pen += ttfReader_->getKerning(previous, glyphIndex);
+        previous = glyphIndex;
         
+        int penX = static_cast<int>(std::lround(pen * scale));
+        pen += ttfReader_->getAdvanceWidth(glyphIndex);
+        if (codepoint == ' ') continue;
         
-        currentX += glyph.advance;
+        GlyphRun::Glyph glyph;
+        glyph.handle = useFields ? getDistanceField(glyphs, codepoint) : getGlyph(glyphs, codepoint, fontSize);
+        glyph.x = penX;
+        run.glyphs.push_back(glyph);
     }
+    
+    run.width = scaled(pen, fontSize);
+    // Read last: adding glyphs may have evicted other sizes
+    run.generation = cacheGeneration_;
 }
 
-int TTFFontRenderer::getTextWidth(const std::string& text, int fontSize) {
-    int totalWidth = 0;
-    
-    for (char c : text) {
-        if (c == ' ') {
-            totalWidth += fontSize / 2;
-            continue;
+void TTFFontRenderer::drawRun(Canvas* canvas, const GlyphRun& run, int x, int y, uint32_t color) {
+    if (run.mode == GlyphMode::DistanceField) {
+        float fieldScale = static_cast<float>(run.fontSize) / kFieldSize;
+        for (const GlyphRun::Glyph& glyph : run.glyphs) {
+            drawDistanceField(canvas, glyph.handle, x + glyph.x, y, fieldScale, color);
+        }
+    } else {
+        for (const GlyphRun::Glyph& glyph : run.glyphs) {
+            drawGlyph(canvas, glyph.handle, x + glyph.x, y, color);
         }
+    }
+}
+
+void TTFFontRenderer::drawGlyph(Canvas* canvas, const GlyphHandle& glyph, int x, int y, uint32_t color) {
+    int originX = x + glyph.bearingX;
+    int originY = y - glyph.bearingY;
+    
+    // Clamp the glyph to the clip once; skip it entirely when hidden
+    Rect area = Rect(originX, originY, glyph.width, glyph.height).intersected(canvas->getClip());
+    if (area.isEmpty()) return;
+    canvas->addDamage(area.x, area.y, area.width, area.height);
+    
+    // Blend coverage straight from the atlas rows
+    uint32_t* buffer = canvas->getBuffer();
+    int stride = canvas->getWidth();
+    for (int py = area.y; py < area.bottom(); py++) {
+        const uint8_t* coverage = glyph.row(py - originY) + (area.x - originX);
+        Span::blendMask(buffer + py * stride + area.x, coverage, area.width, color);
+    }
+}
+
+void TTFFontRenderer::drawDistanceField(Canvas* canvas, const GlyphHandle& glyph, int x, int y,
+                                        float scale, uint32_t color) {
+    if (!glyph.atlas) return;
+    
+    // Where the field lands at this size, in fractional pixels. The
+    // padding is all outside the ramp but for about a pixel, so skip it.
+    float fieldX = x + glyph.bearingX * scale;
+    float fieldY = y - glyph.bearingY * scale;
+    float inset = std::max(0.0f, kFieldPadding * scale - 1.0f);
+    int left = static_cast<int>(std::floor(fieldX + inset));
+    int top = static_cast<int>(std::floor(fieldY + inset));
+    int right = static_cast<int>(std::ceil(fieldX + glyph.width * scale - inset));
+    int bottom = static_cast<int>(std::ceil(fieldY + glyph.height * scale - inset));
+    
+    Rect area = Rect(left, top, right - left, bottom - top).intersected(canvas->getClip());
+    if (area.isEmpty()) return;
+    canvas->addDamage(area.x, area.y, area.width, area.height);
+    
+    // Field columns to sample per destination column, shared by every row
+    float maxX = static_cast<float>(glyph.width - 1);
+    float maxY = static_cast<float>(glyph.height - 1);
+    fieldColumns_.resize(area.width);
+    fieldWeights_.resize(area.width);
+    for (int i = 0; i < area.width; i++) {
+        float fx = std::min(std::max((area.x + i + 0.5f - fieldX) / scale - 0.5f, 0.0f), maxX);
+        fieldColumns_[i] = static_cast<int>(fx);
+        fieldWeights_[i] = fx - fieldColumns_[i];
+    }
+    int firstColumn = fieldColumns_.front();
+    int lastColumn = std::min(fieldColumns_.back() + 1, glyph.width - 1);
+    fieldRow_.resize(glyph.width + 1);
+    fieldCoverage_.resize(area.width);
+    
+    uint32_t* buffer = canvas->getBuffer();
+    int stride = canvas->getWidth();
+    DistanceField::Ramp ramp(static_cast<float>(kFieldRadius), scale);
+    for (int py = area.y; py < area.bottom(); py++) {
+        float fy = std::min(std::max((py + 0.5f - fieldY) / scale - 0.5f, 0.0f), maxY);
+        int y0 = static_cast<int>(fy);
+        int y1 = std::min(y0 + 1, glyph.height - 1);
+        float ty = fy - y0;
+        const uint8_t* row0 = glyph.row(y0);
+        const uint8_t* row1 = glyph.row(y1);
         
-        RasterizedGlyph glyph = rasterizeGlyph(c, fontSize);
-        totalWidth += glyph.advance;
+        // Bilinear sample of the distance: blend the two field rows, then
+        // neighbouring columns; a one-pixel ramp across the edge follows
+        float* blended = fieldRow_.data();
+        for (int fx = firstColumn; fx <= lastColumn; fx++) {
+            blended[fx] = row0[fx] + (row1[fx] - row0[fx]) * ty;
+        }
+        blended[lastColumn + 1] = blended[lastColumn];
+        for (int i = 0; i < area.width; i++) {
+            int fx = fieldColumns_[i];
+            float value = blended[fx] + (blended[fx + 1] - blended[fx]) * fieldWeights_[i];
+            fieldCoverage_[i] = ramp(value);
+        }
+        Span::blendMask(buffer + py * stride + area.x, fieldCoverage_.data(), area.width, color);
+    }
+}
+
+int TTFFontRenderer::getAdvance(uint32_t codepoint, int fontSize) {
+    return scaled(ttfReader_->getAdvanceWidth(getGlyphIndex(codepoint)), fontSize);
+}
+
+int TTFFontRenderer::getKerning(uint32_t left, uint32_t right, int fontSize) {
+    return scaled(ttfReader_->getKerning(getGlyphIndex(left), getGlyphIndex(right)), fontSize);
+}
+
+int TTFFontRenderer::getAdvanceUnits(uint32_t codepoint) {
+    return ttfReader_->getAdvanceWidth(getGlyphIndex(codepoint));
+}
+
+int TTFFontRenderer::getKerningUnits(uint32_t left, uint32_t right) {
+    return ttfReader_->getKerning(getGlyphIndex(left), getGlyphIndex(right));
+}
+
+int TTFFontRenderer::getTextWidth(const std::string& text, int fontSize) {
+    // Same pen walk as renderText(), minus the glyphs
+    int32_t pen = 0;
+    uint16_t previous = 0;
+    
+    for (size_t i = 0; i < text.size();) {
+        bool first = i == 0;
+        uint16_t glyphIndex = getGlyphIndex(Utf8::decode(text, i));
+        if (!first) pen += ttfReader_->getKerning(previous, glyphIndex);
+        pen += ttfReader_->getAdvanceWidth(glyphIndex);
+        previous = glyphIndex;
     }
     
-    return totalWidth;
+    return scaled(pen, fontSize);
+}
+
+int TTFFontRenderer::getAscent(int fontSize) {
+    return scaled(ttfReader_->getVerticalMetrics().ascender, fontSize);
+}
+
+int TTFFontRenderer::getDescent(int fontSize) {
+    return scaled(-ttfReader_->getVerticalMetrics().descender, fontSize);
 }
 
 int TTFFontRenderer::getTextHeight(int fontSize) {
-    return fontSize;
+    return getAscent(fontSize) + getDescent(fontSize);
 }
 
 int TTFFontRenderer::getLineHeight(int fontSize) {
-    return static_cast<int>(fontSize * 1.2f);
+    return getTextHeight(fontSize) + scaled(ttfReader_->getVerticalMetrics().lineGap, fontSize);
 }
 
 std::string TTFFontRenderer::getFontName() const {
     return "TTF Font";
 }
 
-uint32_t TTFFontRenderer::blendPixel(uint32_t background, uint32_t foreground, uint8_t alpha) {
-    if (alpha == 0) return background;
-    if (alpha == 255) return foreground;
-    
-    float a = alpha / 255.0f;
-    float invA = 1.0f - a;
-    
-    uint8_t bgR = (background >> 16) & 0xFF;
-    uint8_t bgG = (background >> 8) & 0xFF;
-    uint8_t bgB = background & 0xFF;
-    uint8_t bgA = (background >> 24) & 0xFF;
-    
-    uint8_t fgR = (foreground >> 16) & 0xFF;
-    uint8_t fgG = (foreground >> 8) & 0xFF;
-    uint8_t fgB = foreground & 0xFF;
-    uint8_t fgA = (foreground >> 24) & 0xFF;
-    
-    uint8_t outR = static_cast<uint8_t>(fgR * a + bgR * invA);
-    uint8_t outG = static_cast<uint8_t>(fgG * a + bgG * invA);
-    uint8_t outB = static_cast<uint8_t>(fgB * a + bgB * invA);
-    uint8_t outA = std::max(bgA, fgA);
-    
-    return (outA << 24) | (outR << 16) | (outG << 8) | outB;
-}
-
 bool TTFFontManager::loadFont(const std::string& name, const std::string& fontPath) {
     try {
         auto renderer = std::make_unique<TTFFontRenderer>(fontPath);
         fonts_[name] = std::move(renderer);
+        generation_++;
         
         if (defaultFontName_.empty()) {
             defaultFontName_ = name;
@@ -228,14 +501,32 @@ bool TTFFontManager::loadFont(const std::string& name, const std::string& fontPa
     }
 }
 
+bool TTFFontManager::loadFont(const std::string& name, const uint8_t* data, size_t size) {
+    try {
+        auto renderer = std::make_unique<TTFFontRenderer>(data, size);
+        fonts_[name] = std::move(renderer);
+        generation_++;
+        
+        if (defaultFontName_.empty()) {
+            defaultFontName_ = name;
+        }
+        
+        return true;
+    } catch (const std::runtime_error& e) {
+        return false;
+    }
+}
+
 TTFFontRenderer* TTFFontManager::getFont(const std::string& name) {
     auto it = fonts_.find(name);
-    return (it != fonts_.end()) ? it->second.get() : nullptr;
+    if (it == fonts_.end()) return nullptr;
+    return it->second.get();
 }
 
 void TTFFontManager::setDefaultFont(const std::string& name) {
     if (fonts_.find(name) != fonts_.end()) {
         defaultFontName_ = name;
+        generation_++;
     }
 }
 
@@ -249,231 +540,52 @@ TTFFontRenderer* TTFFontManager::getDefaultFont() {
 void TTFFontManager::clearAllCaches() {
     for (auto& fontPair : fonts_) {
         fontPair.second->clearCache();
+        fontPair.second->clearOutlineCache();
     }
 }
 
-void TTFFontRenderer::rasterizeGlyphContours(const SimpleGlyph& glyph, RasterizedGlyph& output, float scale) {
-
-    size_t pointIndex = 0;
-    
-    for (size_t contour = 0; contour < glyph.endPtsOfContours.size(); contour++) {
-        size_t startPt = pointIndex;
-        size_t endPt = glyph.endPtsOfContours[contour];
-        
-      
-        std::vector<Point2D> contourPoints = generateHighQualityContour(glyph, startPt, endPt, scale);
-        
-        
-        rasterizeContourLine(contourPoints, output);
-        
-        pointIndex = endPt + 1;
-    }
-    
-    fillInterior(output);
-}
-
-std::vector<TTFFontRenderer::Point2D> TTFFontRenderer::generateHighQualityContour(
-    const SimpleGlyph& glyph, size_t startPt, size_t endPt, float scale) {
-    
-    std::vector<Point2D> contourPoints;
-    
-    if (startPt > endPt || endPt >= glyph.points.size()) return contourPoints;
-    
-    auto transformPoint = [&](const TTFPoint& pt) -> Point2D {
-        float x = (pt.x - glyph.header.xMin) * scale + 2; 
-        float y = (glyph.header.yMax - pt.y) * scale + 2;
-        return {x, y};
-    };
-    
-    const auto& firstPoint = glyph.points[startPt];
-    Point2D startPos = transformPoint(firstPoint);
-    contourPoints.push_back(startPos);
-    
-    for (size_t i = startPt; i <= endPt; i++) {
-        size_t nextIndex = (i == endPt) ? startPt : i + 1; 
-        
-        const auto& currentPt = glyph.points[i];
-        const auto& nextPt = glyph.points[nextIndex];
-        
-        Point2D nextPos = transformPoint(nextPt);
-        
-        if (nextPt.onCurve) {
-            contourPoints.push_back(nextPos);
-        } else {
-            size_t endIndex = (nextIndex == endPt) ? startPt : nextIndex + 1;
-            if (endIndex > endPt) endIndex = startPt;
-            
-            const auto& endPoint = glyph.points[endIndex];
-            Point2D endPos;
-            
-            if (endPoint.onCurve) {
-                endPos = transformPoint(endPoint);
-                i++; 
-            } else {
-                Point2D impliedPoint;
-                impliedPoint.x = (nextPt.x + endPoint.x) / 2.0f;
-                impliedPoint.y = (nextPt.y + endPoint.y) / 2.0f;
-                endPos = transformPoint({static_cast<int16_t>(impliedPoint.x), static_cast<int16_t>(impliedPoint.y), true});
-            }
-            
-            Point2D currentPos = contourPoints.back();
-            Point2D controlPos = transformPoint(nextPt);
-            
-            int resolution = std::max(6, static_cast<int>(scale * 6));
-            for (int j = 1; j <= resolution; j++) {
-                float t = static_cast<float>(j) / resolution;
-                Point2D curvePoint = quadraticBezier(currentPos, controlPos, endPos, t);
-                contourPoints.push_back(curvePoint);
-            }
-        }
-    }
-    
-    return contourPoints;
+void TTFFontManager::setCacheBudget(size_t bytes) {
+    cacheBudget_ = bytes;
+    trimCaches();
 }
 
-void TTFFontRenderer::rasterizeContourLine(const std::vector<Point2D>& points, RasterizedGlyph& output) {
-    if (points.size() < 2) return;
+void TTFFontManager::trimCaches() {
+    if (cacheBudget_ == 0) return;
     
-    for (size_t i = 0; i < points.size() - 1; i++) {
-        drawLine(points[i], points[i + 1], output);
+    size_t total = 0;
+    for (const auto& fontPair : fonts_) {
+        total += fontPair.second->getCacheBytes();
     }
     
-    if (points.size() > 2) {
-        drawLine(points.back(), points.front(), output);
-    }
-}
-
-void TTFFontRenderer::fillInterior(RasterizedGlyph& output) {
-    for (int y = 0; y < output.height; y++) {
-        std::vector<int> crossings;
-        
-        for (int x = 0; x < output.width; x++) {
-            bool currentPixel = output.bitmap[y * output.width + x] > 0;
-            
-            if (currentPixel) {
-                bool isVerticalCrossing = false;
-                
-                // Check pixel above
-                if (y > 0) {
-                    bool pixelAbove = output.bitmap[(y - 1) * output.width + x] > 0;
-                    if (!pixelAbove) {
-                        isVerticalCrossing = true;
-                    }
-                }
-                
-                // Check pixel below
-                if (y < output.height - 1) {
-                    bool pixelBelow = output.bitmap[(y + 1) * output.width + x] > 0;
-                    if (!pixelBelow) {
-                        isVerticalCrossing = true;
-                    }
-                }
-                
-                if (y == 0 || y == output.height - 1) {
-                    isVerticalCrossing = true;
-                }
-                
-                bool isIsolatedPixel = true;
-                if (x > 0 && output.bitmap[y * output.width + (x - 1)] > 0) {
-                    isIsolatedPixel = false;
-                }
-                if (x < output.width - 1 && output.bitmap[y * output.width + (x + 1)] > 0) {
-                    isIsolatedPixel = false;
-                }
-                
-                if (isVerticalCrossing || isIsolatedPixel) {
-                    crossings.push_back(x);
-                }
+    // Least recently used size across all fonts goes first
+    while (total > cacheBudget_) {
+        TTFFontRenderer* oldest = nullptr;
+        for (const auto& fontPair : fonts_) {
+            TTFFontRenderer* font = fontPair.second.get();
+            if (font->getOldestUse() == ~uint64_t(0)) continue;
+            if (!oldest || font->getOldestUse() < oldest->getOldestUse()) {
+                oldest = font;
             }
         }
+        if (!oldest) break;
         
-        std::vector<int> filteredCrossings;
-        for (size_t i = 0; i < crossings.size(); i++) {
-            bool isConsecutive = false;
-            if (i > 0 && crossings[i] == crossings[i-1] + 1) {
-                isConsecutive = true;
-            }
-            if (i < crossings.size() - 1 && crossings[i] == crossings[i+1] - 1) {
-                isConsecutive = true;
-            }
-            
-            if (!isConsecutive) {
-                filteredCrossings.push_back(crossings[i]);
-            }
-        }
-        
-        // Fill between pairs of crossings
-        for (size_t i = 0; i + 1 < filteredCrossings.size(); i += 2) {
-            for (int x = filteredCrossings[i] + 1; x < filteredCrossings[i + 1]; x++) {
-                if (x >= 0 && x < output.width) {
-                    output.bitmap[y * output.width + x] = 255;
-                }
-            }
-        }
-    }
-}
-
-void TTFFontRenderer::drawLine(const Point2D& p1, const Point2D& p2, RasterizedGlyph& output) {
-    // Bresenham's line algorithm with bounds checking
-    int x0 = static_cast<int>(std::round(p1.x));
-    int y0 = static_cast<int>(std::round(p1.y));
-    int x1 = static_cast<int>(std::round(p2.x));
-    int y1 = static_cast<int>(std::round(p2.y));
-    
-    int dx = abs(x1 - x0);
-    int dy = abs(y1 - y0);
-    int sx = (x0 < x1) ? 1 : -1;
-    int sy = (y0 < y1) ? 1 : -1;
-    int err = dx - dy;
-    
-    int x = x0, y = y0;
-    int pixelsDrawn = 0;
-    
-    while (true) {
-        // Set pixel if within bounds
-        if (x >= 0 && x < output.width && y >= 0 && y < output.height) {
-            output.bitmap[y * output.width + x] = 255;
-            pixelsDrawn++;
-        }
-        
-        if (x == x1 && y == y1) break;
-        
-        int e2 = 2 * err;
-        if (e2 > -dy) {
-            err -= dy;
-            x += sx;
-        }
-        if (e2 < dx) {
-            err += dx;
-            y += sy;
-        }
+        size_t before = oldest->getCacheBytes();
+        if (!oldest->evictOldest()) break;
+        total -= before - oldest->getCacheBytes();
     }
 }
 
-void TTFFontRenderer::fillContour(RasterizedGlyph& output) {
-    // Simple scanline fill algorithm 
-    for (int y = 0; y < output.height; y++) {
-        bool inside = false;
-        for (int x = 0; x < output.width; x++) {
-            int idx = y * output.width + x;
-            if (output.bitmap[idx] > 0) {
-                inside = !inside; // Toggle when hitting outline
-            } else if (inside) {
-                output.bitmap[idx] = 255; // Fill interior
-            }
-        }
+TTFFontRenderer::CacheStats TTFFontManager::getCacheStats() const {
+    TTFFontRenderer::CacheStats stats;
+    for (const auto& fontPair : fonts_) {
+        stats += fontPair.second->getCacheStats();
     }
+    return stats;
 }
 
-TTFFontRenderer::Point2D TTFFontRenderer::quadraticBezier(const Point2D& start, const Point2D& control, const Point2D& end, float t) {
-    // Linear interpolation helper
-    auto lerp = [](const Point2D& p1, const Point2D& p2, float t) -> Point2D {
-        return {p1.x + t * (p2.x - p1.x), p1.y + t * (p2.y - p1.y)};
-    };
-    
-    Point2D p01 = lerp(start, control, t);
-    Point2D p12 = lerp(control, end, t);
-    return lerp(p01, p12, t);
+TTFFontRenderer::CacheStats TTFFontManager::getCacheStats(const std::string& name) const {
+    auto it = fonts_.find(name);
+    return it != fonts_.end() ? it->second->getCacheStats() : TTFFontRenderer::CacheStats();
 }
 
 } // namespace Fern
\ No newline at end of file
@@ -1,83 +1,182 @@
 #include "../../include/fern/font/ttf_reader.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <iomanip>
 #ifdef __EMSCRIPTEN__
 #include <emscripten.h>
 #endif
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(__EMSCRIPTEN__)
+#define TTF_READER_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Sequential big-endian reads within [pos, end); once a read runs past the
+// end the cursor stays failed and returns zeros.
+struct ByteCursor {
+    const TTFBytes& bytes;
+    size_t pos;
+    size_t end;
+    bool ok = true;
+    
+    ByteCursor(const TTFBytes& bytes, size_t pos, size_t end)
+        : bytes(bytes), pos(pos), end(end < bytes.size ? end : bytes.size) {}
+    
+    bool take(size_t count) {
+        if (!ok || pos > end || count > end - pos) {
+            ok = false;
+            return false;
+        }
+        pos += count;
+        return true;
+    }
+    uint8_t u8() { return take(1) ? bytes.data[pos - 1] : 0; }
+    uint16_t u16() { return take(2) ? bytes.u16(pos - 2) : 0; }
+    int16_t i16() { return static_cast<int16_t>(u16()); }
+};
+
+}
 
 TTFReader::TTFReader() {
-    littleEndian = isLittleEndian();
 }
 
 TTFReader::~TTFReader() {
     close();
 }
 
-bool TTFReader::isLittleEndian() {
-    uint16_t test = 1;
-    return reinterpret_cast<uint8_t*>(&test)[0] == 1;
+bool TTFReader::openFont(const std::string& filename) {
+    close();
+    
+#ifdef TTF_READER_MMAP
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    
+    struct stat info;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        void* addr = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr != MAP_FAILED) {
+            mapping = addr;
+            mappingSize = static_cast<size_t>(info.st_size);
+        }
+    }
+    ::close(fd);
+    
+    if (mapping) {
+        bytes.data = static_cast<const uint8_t*>(mapping);
+        bytes.size = mappingSize;
+        if (indexTables()) return true;
+        close();
+        return false;
+    }
+#endif
+    
+    // No mmap here (or it failed): read the whole file in one go
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) return false;
+    
+    std::streamsize length = file.tellg();
+    if (length <= 0) return false;
+    
+    ownedData.resize(static_cast<size_t>(length));
+    file.seekg(0, std::ios::beg);
+    if (!file.read(reinterpret_cast<char*>(ownedData.data()), length)) {
+        close();
+        return false;
+    }
+    
+    bytes.data = ownedData.data();
+    bytes.size = ownedData.size();
+    if (indexTables()) return true;
+    close();
+    return false;
 }
 
-uint16_t TTFReader::swapUint16(uint16_t val) {
-    return (val << 8) | (val >> 8);
+bool TTFReader::openFontData(const uint8_t* data, size_t size) {
+    close();
+    if (!data || size == 0) return false;
+    
+    bytes.data = data;
+    bytes.size = size;
+    if (indexTables()) return true;
+    close();
+    return false;
 }
 
-uint32_t TTFReader::swapUint32(uint32_t val) {
-    return (val << 24) | ((val & 0x0000FF00) << 8) | 
-           ((val & 0x00FF0000) >> 8) | (val >> 24);
+void TTFReader::close() {
+#ifdef TTF_READER_MMAP
+    if (mapping) {
+        munmap(mapping, mappingSize);
+    }
+#endif
+    mapping = nullptr;
+    mappingSize = 0;
+    ownedData.clear();
+    ownedData.shrink_to_fit();
+    bytes = TTFBytes();
+    cursor = 0;
+    tables.clear();
+    glyphOffsets.clear();
+    cmapLoaded = false;
+    cmapFormat = 0;
+    cmapGroups.clear();
+    metricsLoaded = false;
+    kernPairCount = 0;
 }
 
-bool TTFReader::openFont(const std::string& filename) {
+bool TTFReader::indexTables() {
+    TTFHeader header;
+    cursor = 0;
+    if (!readHeader(header)) return false;
     
-    file.open(filename, std::ios::binary);
-    bool success = file.is_open();
-    return success;
-}
-
-void TTFReader::close() {
-    if (file.is_open()) {
-        file.close();
+    tables.clear();
+    tables.reserve(header.numTables);
+    for (int i = 0; i < header.numTables; i++) {
+        TableEntry entry;
+        if (!readTableEntry(entry)) return false;
+        
+        // A table running past the end of the data is as good as missing
+        if (bytes.has(entry.offset, entry.length)) {
+            tables.push_back(entry);
+        }
     }
+    
+    cursor = 0;
+    return !tables.empty();
 }
 
 bool TTFReader::readHeader(TTFHeader& header) {
-    if (!file.good()) return false;
-    
-    file.read(reinterpret_cast<char*>(&header.scalerType), 4);
-    file.read(reinterpret_cast<char*>(&header.numTables), 2);
-    file.read(reinterpret_cast<char*>(&header.searchRange), 2);
-    file.read(reinterpret_cast<char*>(&header.entrySelector), 2);
-    file.read(reinterpret_cast<char*>(&header.rangeShift), 2);
+    if (!bytes.has(cursor, 12)) return false;
     
-    if (littleEndian) {
-        header.scalerType = swapUint32(header.scalerType);
-        header.numTables = swapUint16(header.numTables);
-        header.searchRange = swapUint16(header.searchRange);
-        header.entrySelector = swapUint16(header.entrySelector);
-        header.rangeShift = swapUint16(header.rangeShift);
-    }
+    header.scalerType = bytes.u32(cursor);
+    header.numTables = bytes.u16(cursor + 4);
+    header.searchRange = bytes.u16(cursor + 6);
+    header.entrySelector = bytes.u16(cursor + 8);
+    header.rangeShift = bytes.u16(cursor + 10);
+    cursor += 12;
     
-    return file.good();
+    return true;
 }
 
 bool TTFReader::readTableEntry(TableEntry& entry) {
-    if (!file.good()) return false;
+    if (!bytes.has(cursor, 16)) return false;
     
-    file.read(entry.tag, 4);
+    std::memcpy(entry.tag, bytes.data + cursor, 4);
     entry.tag[4] = '\0';  // Null terminate
     
-    file.read(reinterpret_cast<char*>(&entry.checksum), 4);
-    file.read(reinterpret_cast<char*>(&entry.offset), 4);
-    file.read(reinterpret_cast<char*>(&entry.length), 4);
-    
-    if (littleEndian) {
-        entry.checksum = swapUint32(entry.checksum);
-        entry.offset = swapUint32(entry.offset);
-        entry.length = swapUint32(entry.length);
-    }
+    entry.checksum = bytes.u32(cursor + 4);
+    entry.offset = bytes.u32(cursor + 8);
+    entry.length = bytes.u32(cursor + 12);
+    cursor += 16;
     
-    return file.good();
+    return true;
 }
 
+
 void TTFReader::printHeader(const TTFHeader& header) {
     std::cout << "TTF Header:" << std::endl;
     std::cout << "  scalerType: 0x" << std::hex << header.scalerType << std::dec;
@@ -97,21 +196,10 @@ void TTFReader::printTableEntry(const TableEntry& entry) {
 
 
 bool TTFReader::findTable(const std::string& tableName, TableEntry& entry) {
-    // Reset to start of file and skip header
-    file.seekg(12, std::ios::beg);
-    
-    TTFHeader header;
-    file.seekg(0, std::ios::beg);
-    if (!readHeader(header)) return false;
-    
-    // Search through table entries
-    for (int i = 0; i < header.numTables; i++) {
-        TableEntry tempEntry;
-        if (readTableEntry(tempEntry)) {
-            if (std::string(tempEntry.tag) == tableName) {
-                entry = tempEntry;
-                return true;
-            }
+    for (const TableEntry& table : tables) {
+        if (tableName == table.tag) {
+            entry = table;
+            return true;
         }
     }
     return false;
@@ -120,21 +208,23 @@ bool TTFReader::findTable(const std::string& tableName, TableEntry& entry) {
 bool TTFReader::seekToTable(const std::string& tableName) {
     TableEntry entry;
     if (findTable(tableName, entry)) {
-        file.seekg(entry.offset, std::ios::beg);
+        cursor = entry.offset;
         return true;
     }
     return false;
 }
 
 std::vector<uint8_t> TTFReader::readBytes(size_t count) {
-    std::vector<uint8_t> data(count);
-    file.read(reinterpret_cast<char*>(data.data()), count);
+    // Clamp to the bytes actually left
+    size_t available = cursor < bytes.size ? bytes.size - cursor : 0;
+    if (count > available) count = available;
     
-    // Resize to actual bytes read
-    data.resize(file.gcount());
+    std::vector<uint8_t> data(bytes.data + cursor, bytes.data + cursor + count);
+    cursor += count;
     return data;
 }
 
+
 void TTFReader::printHexDump(const std::vector<uint8_t>& data, size_t offset) {
     std::cout << "Hex dump (" << data.size() << " bytes):" << std::endl;
     
@@ -156,65 +246,68 @@ void TTFReader::printHexDump(const std::vector<uint8_t>& data, size_t offset) {
 
 
 bool TTFReader::readGlyphHeader(GlyphHeader& header) {
-    if (!file.good()) return false;
-    
-    file.read(reinterpret_cast<char*>(&header.numberOfContours), 2);
-    file.read(reinterpret_cast<char*>(&header.xMin), 2);
-    file.read(reinterpret_cast<char*>(&header.yMin), 2);
-    file.read(reinterpret_cast<char*>(&header.xMax), 2);
-    file.read(reinterpret_cast<char*>(&header.yMax), 2);
-    
-    if (littleEndian) {
-        header.numberOfContours = static_cast<int16_t>(swapUint16(header.numberOfContours));
-        header.xMin = static_cast<int16_t>(swapUint16(header.xMin));
-        header.yMin = static_cast<int16_t>(swapUint16(header.yMin));
-        header.xMax = static_cast<int16_t>(swapUint16(header.xMax));
-        header.yMax = static_cast<int16_t>(swapUint16(header.yMax));
-    }
-    return file.good();
+    if (!bytes.has(cursor, 10)) return false;
+    
+    header.numberOfContours = bytes.i16(cursor);
+    header.xMin = bytes.i16(cursor + 2);
+    header.yMin = bytes.i16(cursor + 4);
+    header.xMax = bytes.i16(cursor + 6);
+    header.yMax = bytes.i16(cursor + 8);
+    cursor += 10;
+    return true;
 }
 
 bool TTFReader::readSimpleGlyph(SimpleGlyph& glyph) {
-    if(!readGlyphHeader(glyph.header)) return false;
+    size_t next = cursor;
+    bool success = parseSimpleGlyph(cursor, bytes.size, glyph, next);
+    cursor = next;
+    return success;
+}
+
+bool TTFReader::parseSimpleGlyph(size_t offset, size_t end, SimpleGlyph& glyph, size_t& next) {
+    ByteCursor in(bytes, offset, end);
+    
+    glyph.header.numberOfContours = in.i16();
+    glyph.header.xMin = in.i16();
+    glyph.header.yMin = in.i16();
+    glyph.header.xMax = in.i16();
+    glyph.header.yMax = in.i16();
+    if (!in.ok) return false;
 
     if (glyph.header.numberOfContours < 0) {
-        std::cout << "Composite glyph - not implemented yet" << std::endl;
+        // Composites need the loca table; see readGlyphByIndex()
+        next = in.pos;
         return false;
     }
 
     glyph.endPtsOfContours.resize(glyph.header.numberOfContours);
     for (int i = 0; i < glyph.header.numberOfContours; i++) {
-        uint16_t endPt;
-        file.read(reinterpret_cast<char*>(&endPt), 2);
-        if (littleEndian) endPt = swapUint16(endPt);
-        glyph.endPtsOfContours[i] = endPt;
+        glyph.endPtsOfContours[i] = in.u16();
     }
+    if (!in.ok || glyph.endPtsOfContours.empty()) return false;
 
     uint16_t numPoints = glyph.endPtsOfContours.back() + 1;
 
-    uint16_t instructionLength;
-    file.read(reinterpret_cast<char*>(&instructionLength), 2);
-    if (littleEndian) instructionLength = swapUint16(instructionLength);
-    file.seekg(instructionLength, std::ios::cur); // Skip instructions
+    uint16_t instructionLength = in.u16();
+    in.take(instructionLength); // Skip instructions
     
     std::vector<uint8_t> flags;
     flags.reserve(numPoints);
 
-    for (uint16_t i = 0; i < numPoints; ) {
-        uint8_t flag;
-        file.read(reinterpret_cast<char*>(&flag), 1);
+    for (uint16_t i = 0; i < numPoints && in.ok; ) {
+        uint8_t flag = in.u8();
         flags.push_back(flag);
         i++;
         
         // Handle repeat flag
         if (flag & 0x08) { // REPEAT_FLAG
-            uint8_t repeatCount;
-            file.read(reinterpret_cast<char*>(&repeatCount), 1);
+            uint8_t repeatCount = in.u8();
             for (int j = 0; j < repeatCount && i < numPoints; j++, i++) {
                 flags.push_back(flag);
             }
         }
     }
+    if (!in.ok) return false;
 
     glyph.points.resize(numPoints);
     int16_t currentX = 0, currentY = 0;
@@ -224,14 +317,10 @@ bool TTFReader::readSimpleGlyph(SimpleGlyph& glyph) {
         glyph.points[i].onCurve = (flag & 0x01) != 0;  
 
         if (flag & 0x02) { // X_SHORT_VECTOR
-            uint8_t deltaX;
-            file.read(reinterpret_cast<char*>(&deltaX), 1);
+            uint8_t deltaX = in.u8();
             currentX += (flag & 0x10) ? deltaX : -deltaX;
         } else if (!(flag & 0x10)) { // X coordinate changed
-            int16_t deltaX;
-            file.read(reinterpret_cast<char*>(&deltaX), 2);
-            if (littleEndian) deltaX = static_cast<int16_t>(swapUint16(deltaX));
-            currentX += deltaX;
+            currentX += in.i16();
         }
 
         glyph.points[i].x = currentX;
@@ -241,21 +330,20 @@ bool TTFReader::readSimpleGlyph(SimpleGlyph& glyph) {
         uint8_t flag = flags[i];
         
         if (flag & 0x04) { // Y_SHORT_VECTOR
-            uint8_t deltaY;
-            file.read(reinterpret_cast<char*>(&deltaY), 1);
+            uint8_t deltaY = in.u8();
             currentY += (flag & 0x20) ? deltaY : -deltaY;
         } else if (!(flag & 0x20)) { // Y coordinate changed
-            int16_t deltaY;
-            file.read(reinterpret_cast<char*>(&deltaY), 2);
-            if (littleEndian) deltaY = static_cast<int16_t>(swapUint16(deltaY));
-            currentY += deltaY;
+            currentY += in.i16();
         }
         glyph.points[i].y = currentY;
     }
-    return true;
+    
+    next = in.pos;
+    return in.ok;
 }
 
 
+
 void TTFReader::printGlyph(const SimpleGlyph& glyph) {
     std::cout << "Glyph Info:" << std::endl;
     std::cout << "  Contours: " << glyph.header.numberOfContours << std::endl;
@@ -361,7 +449,7 @@ bool TTFReader::readMultipleGlyphs(int count) {
         std::cout << "\n--- Parsing glyph " << i << " ---" << std::endl;
         
         // Save current position
-        std::streampos currentPos = file.tellg();
+        size_t currentPos = cursor;
         
         SimpleGlyph glyph;
         if (readSimpleGlyph(glyph)) {
@@ -375,10 +463,9 @@ bool TTFReader::readMultipleGlyphs(int count) {
             std::cout << "Failed to parse glyph " << i << " - trying to skip ahead" << std::endl;
             
             // Go back to where we started and skip a reasonable amount
-            file.clear(); // Clear any error flags
-            file.seekg(currentPos + std::streamoff(100), std::ios::beg); // Skip 100 bytes
+            cursor = currentPos + 100; // Skip 100 bytes
             
-            if (!file.good()) {
+            if (cursor >= bytes.size) {
                 std::cout << "Reached end of glyph data" << std::endl;
                 break;
             }
@@ -400,10 +487,7 @@ void TTFReader::explainLocaTable() {
     std::cout << "Found 'head' table at offset: " << headEntry.offset << std::endl;
     
     // Read indexToLocFormat (at offset 50 in head table)
-    file.seekg(headEntry.offset + 50, std::ios::beg);
-    int16_t indexToLocFormat;
-    file.read(reinterpret_cast<char*>(&indexToLocFormat), 2);
-    if (littleEndian) indexToLocFormat = static_cast<int16_t>(swapUint16(indexToLocFormat));
+    int16_t indexToLocFormat = bytes.i16(headEntry.offset + 50);
     
     bool isLongFormat = (indexToLocFormat == 1);
     std::cout << "Format: " << (isLongFormat ? "Long (4 bytes)" : "Short (2 bytes)") << std::endl;
@@ -426,21 +510,12 @@ void TTFReader::explainLocaTable() {
     std::cout << "Number of glyphs: " << numGlyphs << std::endl;
     
     // Read first 10 entries as example
-    file.seekg(locaEntry.offset, std::ios::beg);
     std::cout << "\nFirst 10 glyph locations:" << std::endl;
     
     for (int i = 0; i < 10 && i < static_cast<int>(numEntries); i++) {
-        uint32_t offset;
-        
-        if (isLongFormat) {
-            file.read(reinterpret_cast<char*>(&offset), 4);
-            if (littleEndian) offset = swapUint32(offset);
-        } else {
-            uint16_t shortOffset;
-            file.read(reinterpret_cast<char*>(&shortOffset), 2);
-            if (littleEndian) shortOffset = swapUint16(shortOffset);
-            offset = shortOffset * 2; // Convert to actual offset
-        }
+        size_t entryOffset = locaEntry.offset + i * entrySize;
+        uint32_t offset = isLongFormat ? bytes.u32(entryOffset)
+                                       : bytes.u16(entryOffset) * 2u; // Convert to actual offset
         
         std::cout << "  Glyph " << i << ": starts at offset " << offset << std::endl;
     }
@@ -453,10 +528,7 @@ bool TTFReader::loadLocaTable() {
     TableEntry headEntry;
     if (!findTable("head", headEntry)) return false;
     
-    file.seekg(headEntry.offset + 50, std::ios::beg);
-    int16_t indexToLocFormat;
-    file.read(reinterpret_cast<char*>(&indexToLocFormat), 2);
-    if (littleEndian) indexToLocFormat = static_cast<int16_t>(swapUint16(indexToLocFormat));
+    int16_t indexToLocFormat = bytes.i16(headEntry.offset + 50);
     
     isLongFormat = (indexToLocFormat == 1);
     
@@ -466,26 +538,15 @@ bool TTFReader::loadLocaTable() {
     
     size_t entrySize = isLongFormat ? 4 : 2;
     size_t numEntries = locaEntry.length / entrySize;
+    if (numEntries == 0) return false;
     
     glyphOffsets.clear();
     glyphOffsets.reserve(numEntries);
     
-    file.seekg(locaEntry.offset, std::ios::beg);
-    
     for (size_t i = 0; i < numEntries; i++) {
-        uint32_t offset;
-        
-        if (isLongFormat) {
-            file.read(reinterpret_cast<char*>(&offset), 4);
-            if (littleEndian) offset = swapUint32(offset);
-        } else {
-            uint16_t shortOffset;
-            file.read(reinterpret_cast<char*>(&shortOffset), 2);
-            if (littleEndian) shortOffset = swapUint16(shortOffset);
-            offset = shortOffset * 2;
-        }
-        
-        glyphOffsets.push_back(offset);
+        size_t entryOffset = locaEntry.offset + i * entrySize;
+        glyphOffsets.push_back(isLongFormat ? bytes.u32(entryOffset)
+                                            : bytes.u16(entryOffset) * 2u);
     }
     
     std::cout << "Loaded " << (numEntries - 1) << " glyph locations" << std::endl;
@@ -494,6 +555,10 @@ bool TTFReader::loadLocaTable() {
 
 
 bool TTFReader::readGlyphByIndex(int glyphIndex, SimpleGlyph& glyph) {
+    return readGlyph(glyphIndex, glyph, 0);
+}
+
+bool TTFReader::readGlyph(int glyphIndex, SimpleGlyph& glyph, int depth) {
     if (glyphOffsets.empty()) {
         if (!loadLocaTable()) return false;
     }
@@ -506,22 +571,133 @@ bool TTFReader::readGlyphByIndex(int glyphIndex, SimpleGlyph& glyph) {
     uint32_t glyphOffset = glyphOffsets[glyphIndex];
     uint32_t nextGlyphOffset = glyphOffsets[glyphIndex + 1];
     
-    if (glyphOffset == nextGlyphOffset) {
+    if (glyphOffset >= nextGlyphOffset) {
         std::cout << "Glyph " << glyphIndex << " is empty (no outline data)" << std::endl;
         return false;
     }
     
     TableEntry glyfEntry;
     if (!findTable("glyf", glyfEntry)) return false;
+    if (nextGlyphOffset > glyfEntry.length) return false;
     
-    file.seekg(glyfEntry.offset + glyphOffset, std::ios::beg);
+    size_t start = static_cast<size_t>(glyfEntry.offset) + glyphOffset;
+    size_t end = static_cast<size_t>(glyfEntry.offset) + nextGlyphOffset;
     
-    std::cout << "Reading glyph " << glyphIndex << " at offset " << (glyfEntry.offset + glyphOffset) 
+    std::cout << "Reading glyph " << glyphIndex << " at offset " << start 
               << " (size: " << (nextGlyphOffset - glyphOffset) << " bytes)" << std::endl;
     
-    return readSimpleGlyph(glyph);
+    // Parse in place, never reading past this glyph's own data
+    if (end - start >= 2 && static_cast<int16_t>(bytes.u16(start)) < 0) {
+        return parseCompositeGlyph(start, end, glyph, depth);
+    }
+    size_t next;
+    bool success = parseSimpleGlyph(start, end, glyph, next);
+    cursor = next;
+    return success;
 }
 
+bool TTFReader::parseCompositeGlyph(size_t offset, size_t end, SimpleGlyph& glyph, int depth) {
+    // Components may be composites themselves; fonts never nest deeply,
+    // so a deep chain is a loop
+    if (depth >= 8) return false;
+    
+    ByteCursor in(bytes, offset, end);
+    glyph.header.numberOfContours = in.i16();
+    glyph.header.xMin = in.i16();
+    glyph.header.yMin = in.i16();
+    glyph.header.xMax = in.i16();
+    glyph.header.yMax = in.i16();
+    glyph.endPtsOfContours.clear();
+    glyph.points.clear();
+    
+    const uint16_t ARG_1_AND_2_ARE_WORDS = 0x0001;
+    const uint16_t ARGS_ARE_XY_VALUES = 0x0002;
+    const uint16_t WE_HAVE_A_SCALE = 0x0008;
+    const uint16_t MORE_COMPONENTS = 0x0020;
+    const uint16_t WE_HAVE_AN_X_AND_Y_SCALE = 0x0040;
+    const uint16_t WE_HAVE_A_TWO_BY_TWO = 0x0080;
+    auto f2dot14 = [&in]() { return in.i16() / 16384.0f; };
+    
+    SimpleGlyph component;
+    uint16_t flags;
+    do {
+        flags = in.u16();
+        uint16_t componentIndex = in.u16();
+        int32_t arg1, arg2;
+        if (flags & ARG_1_AND_2_ARE_WORDS) {
+            arg1 = in.u16();
+            arg2 = in.u16();
+            if (flags & ARGS_ARE_XY_VALUES) {
+                arg1 = static_cast<int16_t>(arg1);
+                arg2 = static_cast<int16_t>(arg2);
+            }
+        } else {
+            arg1 = in.u8();
+            arg2 = in.u8();
+            if (flags & ARGS_ARE_XY_VALUES) {
+                arg1 = static_cast<int8_t>(arg1);
+                arg2 = static_cast<int8_t>(arg2);
+            }
+        }
+        
+        // x' = a*x + c*y + dx, y' = b*x + d*y + dy
+        float a = 1.0f, b = 0.0f, c = 0.0f, d = 1.0f;
+        if (flags & WE_HAVE_A_SCALE) {
+            a = d = f2dot14();
+        } else if (flags & WE_HAVE_AN_X_AND_Y_SCALE) {
+            a = f2dot14();
+            d = f2dot14();
+        } else if (flags & WE_HAVE_A_TWO_BY_TWO) {
+            a = f2dot14();
+            b = f2dot14();
+            c = f2dot14();
+            d = f2dot14();
+        }
+        if (!in.ok) return false;
+        
+        // Empty components (a space in a ligature, say) add nothing
+        if (!readGlyph(componentIndex, component, depth + 1)) continue;
+        
+        auto transform = [&](const TTFPoint& p, float& x, float& y) {
+            x = a * p.x + c * p.y;
+            y = b * p.x + d * p.y;
+        };
+        
+        float dx = 0.0f, dy = 0.0f;
+        if (flags & ARGS_ARE_XY_VALUES) {
+            dx = static_cast<float>(arg1);
+            dy = static_cast<float>(arg2);
+        } else {
+            // Attach the component's point arg2 to the glyph's point arg1
+            if (static_cast<size_t>(arg1) >= glyph.points.size() ||
+                static_cast<size_t>(arg2) >= component.points.size()) return false;
+            float x, y;
+            transform(component.points[arg2], x, y);
+            dx = glyph.points[arg1].x - x;
+            dy = glyph.points[arg1].y - y;
+        }
+        
+        size_t base = glyph.points.size();
+        if (base + component.points.size() > 0xFFFF) return false;
+        for (uint16_t endPt : component.endPtsOfContours) {
+            glyph.endPtsOfContours.push_back(static_cast<uint16_t>(base + endPt));
+        }
+        for (const TTFPoint& p : component.points) {
+            float x, y;
+            transform(p, x, y);
+            TTFPoint moved;
+            moved.x = static_cast<int16_t>(std::lround(x + dx));
+            moved.y = static_cast<int16_t>(std::lround(y + dy));
+            moved.onCurve = p.onCurve;
+            glyph.points.push_back(moved);
+        }
+    } while (flags & MORE_COMPONENTS);
+    
+    cursor = in.pos;
+    return !glyph.points.empty();
+}
+
+
 
 void TTFReader::readMultipleGlyphsByIndex(int startIndex, int count) {
     for (int i = 0; i < count; i++) {
@@ -792,15 +968,14 @@ bool TTFReader::loadCmapTable() {
     }
     
     cmapTableOffset = cmapEntry.offset;
-    file.seekg(cmapTableOffset, std::ios::beg);
     
     // Read cmap header
-    file.read(reinterpret_cast<char*>(&cmapHeader.version), 2);
-    file.read(reinterpret_cast<char*>(&cmapHeader.numTables), 2);
+    cmapHeader.version = bytes.u16(cmapTableOffset);
+    cmapHeader.numTables = bytes.u16(cmapTableOffset + 2);
     
-    if (littleEndian) {
-        cmapHeader.version = swapUint16(cmapHeader.version);
-        cmapHeader.numTables = swapUint16(cmapHeader.numTables);
+    if (!bytes.has(cmapTableOffset + 4, cmapHeader.numTables * 8u)) {
+        std::cout << "cmap subtable list is truncated" << std::endl;
+        return false;
     }
     
     std::cout << "cmap version: " << cmapHeader.version << ", subtables: " << cmapHeader.numTables << std::endl;
@@ -809,34 +984,40 @@ bool TTFReader::loadCmapTable() {
     cmapHeader.subtables.resize(cmapHeader.numTables);
     for (int i = 0; i < cmapHeader.numTables; i++) {
         auto& subtable = cmapHeader.subtables[i];
+        size_t entryOffset = cmapTableOffset + 4 + i * 8;
         
-        file.read(reinterpret_cast<char*>(&subtable.platformID), 2);
-        file.read(reinterpret_cast<char*>(&subtable.encodingID), 2);
-        file.read(reinterpret_cast<char*>(&subtable.offset), 4);
-        
-        if (littleEndian) {
-            subtable.platformID = swapUint16(subtable.platformID);
-            subtable.encodingID = swapUint16(subtable.encodingID);
-            subtable.offset = swapUint32(subtable.offset);
-        }
+        subtable.platformID = bytes.u16(entryOffset);
+        subtable.encodingID = bytes.u16(entryOffset + 2);
+        subtable.offset = bytes.u32(entryOffset + 4);
         
         std::cout << "Subtable " << i << ": Platform " << subtable.platformID 
                   << ", Encoding " << subtable.encodingID 
                   << ", Offset " << subtable.offset << std::endl;
     }
     
-    // Find the best subtable (prefer Unicode BMP)
+    // Find the best subtable: full Unicode (format 12) if the font has
+    // it, else the BMP (format 4)
     int bestSubtable = -1;
+    int bestRank = 0;
     for (int i = 0; i < cmapHeader.numTables; i++) {
         const auto& subtable = cmapHeader.subtables[i];
+        uint32_t subtableOffset = cmapTableOffset + subtable.offset;
+        if (!bytes.has(subtableOffset, 2)) continue;
+        uint16_t format = bytes.u16(subtableOffset);
         
-        // Microsoft Unicode BMP (most common)
-        if (subtable.platformID == 3 && subtable.encodingID == 1) {
-            bestSubtable = i;
-            break;
+        bool unicode = subtable.platformID == 0 ||
+                       (subtable.platformID == 3 && (subtable.encodingID == 1 || subtable.encodingID == 10));
+        int rank = 0;
+        if (unicode && format == 12) {
+            rank = 4;
+        } else if (subtable.platformID == 3 && subtable.encodingID == 1 && format == 4) {
+            rank = 3; // Microsoft Unicode BMP (most common)
+        } else if (unicode && format == 4) {
+            rank = 2;
         }
-        // Unicode (fallback)
-        else if (subtable.platformID == 0) {
+        
+        if (rank > bestRank) {
+            bestRank = rank;
             bestSubtable = i;
         }
     }
@@ -850,30 +1031,23 @@ bool TTFReader::loadCmapTable() {
     
     // Parse the chosen subtable
     uint32_t subtableOffset = cmapTableOffset + cmapHeader.subtables[bestSubtable].offset;
+    if (bytes.u16(subtableOffset) == 12) {
+        return parseCmapFormat12(subtableOffset);
+    }
     return parseCmapFormat4(subtableOffset);
 }
 
 bool TTFReader::parseCmapFormat4(uint32_t subtableOffset) {
-    file.seekg(subtableOffset, std::ios::beg);
-    
     // Read format4 header
-    file.read(reinterpret_cast<char*>(&cmapFormat4.format), 2);
-    file.read(reinterpret_cast<char*>(&cmapFormat4.length), 2);
-    file.read(reinterpret_cast<char*>(&cmapFormat4.language), 2);
-    file.read(reinterpret_cast<char*>(&cmapFormat4.segCountX2), 2);
-    file.read(reinterpret_cast<char*>(&cmapFormat4.searchRange), 2);
-    file.read(reinterpret_cast<char*>(&cmapFormat4.entrySelector), 2);
-    file.read(reinterpret_cast<char*>(&cmapFormat4.rangeShift), 2);
-    
-    if (littleEndian) {
-        cmapFormat4.format = swapUint16(cmapFormat4.format);
-        cmapFormat4.length = swapUint16(cmapFormat4.length);
-        cmapFormat4.language = swapUint16(cmapFormat4.language);
-        cmapFormat4.segCountX2 = swapUint16(cmapFormat4.segCountX2);
-        cmapFormat4.searchRange = swapUint16(cmapFormat4.searchRange);
-        cmapFormat4.entrySelector = swapUint16(cmapFormat4.entrySelector);
-        cmapFormat4.rangeShift = swapUint16(cmapFormat4.rangeShift);
-    }
+    if (!bytes.has(subtableOffset, 14)) return false;
+    
+    cmapFormat4.format = bytes.u16(subtableOffset);
+    cmapFormat4.length = bytes.u16(subtableOffset + 2);
+    cmapFormat4.language = bytes.u16(subtableOffset + 4);
+    cmapFormat4.segCountX2 = bytes.u16(subtableOffset + 6);
+    cmapFormat4.searchRange = bytes.u16(subtableOffset + 8);
+    cmapFormat4.entrySelector = bytes.u16(subtableOffset + 10);
+    cmapFormat4.rangeShift = bytes.u16(subtableOffset + 12);
     
     if (cmapFormat4.format != 4) {
         std::cout << "Unsupported cmap format: " << cmapFormat4.format << std::endl;
@@ -883,54 +1057,79 @@ bool TTFReader::parseCmapFormat4(uint32_t subtableOffset) {
     uint16_t segCount = cmapFormat4.segCountX2 / 2;
     std::cout << "Format 4 cmap with " << segCount << " segments" << std::endl;
     
-    // Read endCode array
-    cmapFormat4.endCode.resize(segCount);
-    for (int i = 0; i < segCount; i++) {
-        file.read(reinterpret_cast<char*>(&cmapFormat4.endCode[i]), 2);
-        if (littleEndian) cmapFormat4.endCode[i] = swapUint16(cmapFormat4.endCode[i]);
+    // Four parallel arrays plus the reserved pad must fit in the subtable
+    size_t arraysSize = segCount * 8u + 2;
+    if (cmapFormat4.length < 14 + arraysSize || !bytes.has(subtableOffset, cmapFormat4.length)) {
+        std::cout << "Format 4 cmap is truncated" << std::endl;
+        return false;
     }
     
-    // Read reserved padding
-    file.read(reinterpret_cast<char*>(&cmapFormat4.reservedPad), 2);
+    size_t endCodeOffset = subtableOffset + 14;
+    size_t startCodeOffset = endCodeOffset + segCount * 2 + 2;
+    size_t idDeltaOffset = startCodeOffset + segCount * 2;
+    size_t idRangeOffsetOffset = idDeltaOffset + segCount * 2;
+    size_t glyphIdArrayOffset = idRangeOffsetOffset + segCount * 2;
     
-    // Read startCode array
+    cmapFormat4.endCode.resize(segCount);
     cmapFormat4.startCode.resize(segCount);
-    for (int i = 0; i < segCount; i++) {
-        file.read(reinterpret_cast<char*>(&cmapFormat4.startCode[i]), 2);
-        if (littleEndian) cmapFormat4.startCode[i] = swapUint16(cmapFormat4.startCode[i]);
-    }
-    
-    // Read idDelta array
     cmapFormat4.idDelta.resize(segCount);
-    for (int i = 0; i < segCount; i++) {
-        file.read(reinterpret_cast<char*>(&cmapFormat4.idDelta[i]), 2);
-        if (littleEndian) cmapFormat4.idDelta[i] = static_cast<int16_t>(swapUint16(cmapFormat4.idDelta[i]));
-    }
-    
-    // Read idRangeOffset array
     cmapFormat4.idRangeOffset.resize(segCount);
     for (int i = 0; i < segCount; i++) {
-        file.read(reinterpret_cast<char*>(&cmapFormat4.idRangeOffset[i]), 2);
-        if (littleEndian) cmapFormat4.idRangeOffset[i] = swapUint16(cmapFormat4.idRangeOffset[i]);
+        cmapFormat4.endCode[i] = bytes.u16(endCodeOffset + i * 2);
+        cmapFormat4.startCode[i] = bytes.u16(startCodeOffset + i * 2);
+        cmapFormat4.idDelta[i] = bytes.i16(idDeltaOffset + i * 2);
+        cmapFormat4.idRangeOffset[i] = bytes.u16(idRangeOffsetOffset + i * 2);
     }
+    cmapFormat4.reservedPad = bytes.u16(endCodeOffset + segCount * 2);
     
-    // Read remaining glyphIdArray
-    std::streampos currentPos = file.tellg();
-    std::streampos endPos = subtableOffset + cmapFormat4.length;
-    size_t remainingBytes = endPos - currentPos;
-    size_t glyphIdArraySize = remainingBytes / 2;
+    // The rest of the subtable is glyphIdArray
+    size_t glyphIdArraySize = (subtableOffset + cmapFormat4.length - glyphIdArrayOffset) / 2;
     
     cmapFormat4.glyphIdArray.resize(glyphIdArraySize);
     for (size_t i = 0; i < glyphIdArraySize; i++) {
-        file.read(reinterpret_cast<char*>(&cmapFormat4.glyphIdArray[i]), 2);
-        if (littleEndian) cmapFormat4.glyphIdArray[i] = swapUint16(cmapFormat4.glyphIdArray[i]);
+        cmapFormat4.glyphIdArray[i] = bytes.u16(glyphIdArrayOffset + i * 2);
     }
     
     std::cout << "Successfully loaded Format 4 cmap" << std::endl;
+    cmapFormat = 4;
     cmapLoaded = true;
     return true;
 }
 
+bool TTFReader::parseCmapFormat12(uint32_t subtableOffset) {
+    // format, reserved, length, language, numGroups
+    if (!bytes.has(subtableOffset, 16)) return false;
+    
+    uint32_t length = bytes.u32(subtableOffset + 4);
+    uint32_t numGroups = bytes.u32(subtableOffset + 12);
+    if (length < 16 || (length - 16) / 12 < numGroups || !bytes.has(subtableOffset, length)) {
+        std::cout << "Format 12 cmap is truncated" << std::endl;
+        return false;
+    }
+    
+    std::cout << "Format 12 cmap with " << numGroups << " groups" << std::endl;
+    
+    // Groups must be sorted and disjoint for the binary search; drop any
+    // that are not
+    cmapGroups.clear();
+    cmapGroups.reserve(numGroups);
+    size_t groupOffset = subtableOffset + 16;
+    for (uint32_t i = 0; i < numGroups; i++, groupOffset += 12) {
+        CmapGroup group;
+        group.startCharCode = bytes.u32(groupOffset);
+        group.endCharCode = bytes.u32(groupOffset + 4);
+        group.startGlyphID = bytes.u32(groupOffset + 8);
+        if (group.endCharCode < group.startCharCode) continue;
+        if (!cmapGroups.empty() && group.startCharCode <= cmapGroups.back().endCharCode) continue;
+        cmapGroups.push_back(group);
+    }
+    
+    cmapFormat = 12;
+    cmapLoaded = true;
+    return true;
+}
+
+
 uint16_t TTFReader::getGlyphIndex(uint32_t unicode) {
     if (!cmapLoaded) {
         if (!loadCmapTable()) {
@@ -938,27 +1137,38 @@ uint16_t TTFReader::getGlyphIndex(uint32_t unicode) {
         }
     }
     
-    // Find the segment containing this character
+    if (cmapFormat == 12) {
+        // Last group starting at or before the character
+        auto it = std::upper_bound(cmapGroups.begin(), cmapGroups.end(), unicode,
+            [](uint32_t code, const CmapGroup& group) { return code < group.startCharCode; });
+        if (it == cmapGroups.begin()) return 0;
+        --it;
+        if (unicode > it->endCharCode) return 0;
+        uint32_t glyphIndex = it->startGlyphID + (unicode - it->startCharCode);
+        return glyphIndex <= 0xFFFF ? static_cast<uint16_t>(glyphIndex) : 0;
+    }
+    
+    if (unicode > 0xFFFF) return 0;
+    
+    // Segments are sorted by end code: the first one ending at or after
+    // the character is the only one that can contain it
     uint16_t segCount = cmapFormat4.segCountX2 / 2;
+    auto end = std::lower_bound(cmapFormat4.endCode.begin(), cmapFormat4.endCode.end(), unicode);
+    if (end == cmapFormat4.endCode.end()) return 0;
+    size_t i = end - cmapFormat4.endCode.begin();
+    if (unicode < cmapFormat4.startCode[i]) return 0;
+    
+    if (cmapFormat4.idRangeOffset[i] == 0) {
+        // Simple case: glyph index = unicode + idDelta[i]
+        return (unicode + cmapFormat4.idDelta[i]) & 0xFFFF;
+    }
     
-    for (int i = 0; i < segCount; i++) {
-        if (unicode <= cmapFormat4.endCode[i] && unicode >= cmapFormat4.startCode[i]) {
-            // Found the segment
-            
-            if (cmapFormat4.idRangeOffset[i] == 0) {
-                // Simple case: glyph index = unicode + idDelta[i]
-                return (unicode + cmapFormat4.idDelta[i]) & 0xFFFF;
-            } else {
-                // Complex case: look up in glyphIdArray
-                uint16_t offset = cmapFormat4.idRangeOffset[i] / 2 + (unicode - cmapFormat4.startCode[i]) - (segCount - i);
-                
-                if (offset < cmapFormat4.glyphIdArray.size()) {
-                    uint16_t glyphIndex = cmapFormat4.glyphIdArray[offset];
-                    if (glyphIndex != 0) {
-                        return (glyphIndex + cmapFormat4.idDelta[i]) & 0xFFFF;
-                    }
-                }
-            }
+    // Complex case: look up in glyphIdArray
+    uint16_t offset = cmapFormat4.idRangeOffset[i] / 2 + (unicode - cmapFormat4.startCode[i]) - (segCount - i);
+    if (offset < cmapFormat4.glyphIdArray.size()) {
+        uint16_t glyphIndex = cmapFormat4.glyphIdArray[offset];
+        if (glyphIndex != 0) {
+            return (glyphIndex + cmapFormat4.idDelta[i]) & 0xFFFF;
         }
     }
     
@@ -971,8 +1181,12 @@ void TTFReader::printCmapInfo() {
     }
     
     std::cout << "\n=== cmap Table Info ===" << std::endl;
-    std::cout << "Format: " << cmapFormat4.format << std::endl;
-    std::cout << "Segments: " << (cmapFormat4.segCountX2 / 2) << std::endl;
+    std::cout << "Format: " << cmapFormat << std::endl;
+    if (cmapFormat == 12) {
+        std::cout << "Groups: " << cmapGroups.size() << std::endl;
+    } else {
+        std::cout << "Segments: " << (cmapFormat4.segCountX2 / 2) << std::endl;
+    }
     
     // Show some example mappings
     std::cout << "\nExample character mappings:" << std::endl;
@@ -984,19 +1198,130 @@ void TTFReader::printCmapInfo() {
 
 bool TTFReader::loadHeadTable() {
     TableEntry headEntry;
-    if (!findTable("head", headEntry)) {
+    if (!findTable("head", headEntry) || headEntry.length < 54) {
         std::cout << "head table not found, using default unitsPerEm = 1000" << std::endl;
         return false;
     }
     
     // Read unitsPerEm from offset 18 in head table
-    file.seekg(headEntry.offset + 18, std::ios::beg);
-    file.read(reinterpret_cast<char*>(&unitsPerEm), 2);
+    unitsPerEm = bytes.u16(headEntry.offset + 18);
     
-    if (littleEndian) {
-        unitsPerEm = swapUint16(unitsPerEm);
+    std::cout << "Font unitsPerEm: " << unitsPerEm << std::endl;
+    return true;
+}
+
+bool TTFReader::loadMetricsTables() {
+    metricsLoaded = false;
+    
+    // Defaults when the tables are missing: one em of text, 20% line gap
+    verticalMetrics = TTFVerticalMetrics();
+    verticalMetrics.ascender = static_cast<int16_t>(unitsPerEm * 4 / 5);
+    verticalMetrics.descender = static_cast<int16_t>(-(unitsPerEm / 5));
+    verticalMetrics.lineGap = static_cast<int16_t>(unitsPerEm / 5);
+    
+    TableEntry hheaEntry, hmtxEntry;
+    if (!findTable("hhea", hheaEntry) || hheaEntry.length < 36 ||
+        !findTable("hmtx", hmtxEntry)) {
+        std::cout << "hhea/hmtx tables not found" << std::endl;
+        return false;
     }
     
-    std::cout << "Font unitsPerEm: " << unitsPerEm << std::endl;
+    verticalMetrics.ascender = bytes.i16(hheaEntry.offset + 4);
+    verticalMetrics.descender = bytes.i16(hheaEntry.offset + 6);
+    verticalMetrics.lineGap = bytes.i16(hheaEntry.offset + 8);
+    numberOfHMetrics = bytes.u16(hheaEntry.offset + 34);
+    
+    hmtxOffset = hmtxEntry.offset;
+    hmtxLength = hmtxEntry.length;
+    if (numberOfHMetrics == 0 || hmtxLength < numberOfHMetrics * 4u) {
+        std::cout << "hmtx table is truncated" << std::endl;
+        return false;
+    }
+    
+    // OS/2 typo metrics win when the font asks for them (USE_TYPO_METRICS)
+    // or hhea has none
+    TableEntry os2Entry;
+    if (findTable("OS/2", os2Entry) && os2Entry.length >= 78) {
+        uint16_t version = bytes.u16(os2Entry.offset);
+        uint16_t fsSelection = bytes.u16(os2Entry.offset + 62);
+        bool hheaEmpty = verticalMetrics.ascender == 0 && verticalMetrics.descender == 0;
+        
+        if ((fsSelection & 0x80) || hheaEmpty) {
+            verticalMetrics.ascender = bytes.i16(os2Entry.offset + 68);
+            verticalMetrics.descender = bytes.i16(os2Entry.offset + 70);
+            verticalMetrics.lineGap = bytes.i16(os2Entry.offset + 72);
+        }
+        if (version >= 2 && os2Entry.length >= 90) {
+            verticalMetrics.xHeight = bytes.i16(os2Entry.offset + 86);
+            verticalMetrics.capHeight = bytes.i16(os2Entry.offset + 88);
+        }
+    }
+    
+    // Horizontal kerning pairs from the first format 0 subtable
+    kernPairsOffset = 0;
+    kernPairCount = 0;
+    TableEntry kernEntry;
+    if (findTable("kern", kernEntry) && bytes.u16(kernEntry.offset) == 0) {
+        uint16_t numSubtables = bytes.u16(kernEntry.offset + 2);
+        size_t subtableOffset = kernEntry.offset + 4;
+        size_t kernEnd = static_cast<size_t>(kernEntry.offset) + kernEntry.length;
+        
+        for (int i = 0; i < numSubtables && subtableOffset + 14 <= kernEnd; i++) {
+            uint16_t length = bytes.u16(subtableOffset + 2);
+            uint16_t coverage = bytes.u16(subtableOffset + 4);
+            
+            // Format 0, horizontal, not cross-stream, not a minimum table
+            if ((coverage >> 8) == 0 && (coverage & 0x07) == 0x01) {
+                // Large tables overflow the 16-bit length, so bound the
+                // pairs by the end of the kern table instead
+                uint32_t count = bytes.u16(subtableOffset + 6);
+                size_t pairsOffset = subtableOffset + 14;
+                size_t maxCount = (kernEnd - pairsOffset) / 6;
+                kernPairsOffset = static_cast<uint32_t>(pairsOffset);
+                kernPairCount = static_cast<uint32_t>(std::min<size_t>(count, maxCount));
+                break;
+            }
+            if (length < 6) break;
+            subtableOffset += length;
+        }
+    }
+    
+    std::cout << "Loaded metrics: " << numberOfHMetrics << " advances, " 
+              << kernPairCount << " kerning pairs" << std::endl;
+    metricsLoaded = true;
     return true;
-}
\ No newline at end of file
+}
+
+uint16_t TTFReader::getAdvanceWidth(uint16_t glyphIndex) const {
+    if (!metricsLoaded) return unitsPerEm / 2;
+    
+    // Glyphs past the last long metric share its advance
+    uint16_t metric = glyphIndex < numberOfHMetrics ? glyphIndex : numberOfHMetrics - 1;
+    return bytes.u16(hmtxOffset + metric * 4u);
+}
+
+int16_t TTFReader::getLeftSideBearing(uint16_t glyphIndex) const {
+    if (!metricsLoaded) return 0;
+    
+    size_t offset = glyphIndex < numberOfHMetrics
+        ? glyphIndex * 4u + 2
+        : numberOfHMetrics * 4u + (glyphIndex - numberOfHMetrics) * 2u;
+    return offset + 2 <= hmtxLength ? bytes.i16(hmtxOffset + offset) : 0;
+}
+
+int16_t TTFReader::getKerning(uint16_t leftGlyph, uint16_t rightGlyph) const {
+    // Pairs are sorted by (left, right); binary search them in place
+    uint32_t key = (static_cast<uint32_t>(leftGlyph) << 16) | rightGlyph;
+    uint32_t low = 0, high = kernPairCount;
+    
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        size_t pair = kernPairsOffset + mid * 6u;
+        uint32_t pairKey = bytes.u32(pair);
+        
+        if (pairKey == key) return bytes.i16(pair + 4);
+        if (pairKey < key) low = mid + 1;
+        else high = mid;
+    }
+    return 0;
+}
@@ -1,174 +1,492 @@
 #include "../../include/fern/graphics/primitives.hpp"
+#include "../../include/fern/graphics/span.hpp"
+#include <algorithm>
 #include <cmath>
+#include <limits>
+#include <vector>
 
 extern Fern::Canvas* globalCanvas;
 
 namespace Fern {
+    namespace {
+        // Half-widths of each disc row, indexed by distance from the center row:
+        // entry dy is the largest dx with dx*dx + dy*dy <= radius*radius.
+        // Widgets draw the same few radii every frame, so the tables for the
+        // most recently used radii are kept, most recent first.
+        class DiscSpanCache {
+        public:
+            const std::vector<int>& get(int radius) {
+                for (size_t i = 0; i < entries_.size(); ++i) {
+                    if (entries_[i].radius == radius) {
+                        std::rotate(entries_.begin(), entries_.begin() + i, entries_.begin() + i + 1);
+                        return entries_.front().halfWidths;
+                    }
+                }
+                
+                if (entries_.size() == kCapacity) {
+                    entries_.pop_back();
+                }
+                entries_.insert(entries_.begin(), Entry{radius, build(radius)});
+                return entries_.front().halfWidths;
+            }
+            
+        private:
+            static constexpr size_t kCapacity = 16;
+            
+            struct Entry {
+                int radius;
+                std::vector<int> halfWidths;
+            };
+            
+            static std::vector<int> build(int radius) {
+                std::vector<int> halfWidths(radius + 1);
+                int r2 = radius * radius;
+                int dx = radius;
+                for (int dy = 0; dy <= radius; ++dy) {
+                    while (dx * dx + dy * dy > r2) --dx;
+                    halfWidths[dy] = dx;
+                }
+                return halfWidths;
+            }
+            
+            std::vector<Entry> entries_;
+        };
+        
+        DiscSpanCache discSpans;
+        
+        // Paint pixels x0..x1 (inclusive) of row py, clipped to the current clip
+        void fillRow(int py, int x0, int x1, uint32_t color) {
+            const Rect& clip = globalCanvas->getClip();
+            if (py < clip.y || py >= clip.bottom()) return;
+            x0 = std::max(x0, clip.x);
+            x1 = std::min(x1, clip.right() - 1);
+            if (x0 > x1) return;
+            Span::paint(globalCanvas->getBuffer() + py * globalCanvas->getWidth() + x0, x1 - x0 + 1, color);
+        }
+        
+        // Horizontal extent x0..x1 of row py of a rounded rectangle, whose
+        // radius is already clamped and whose row lies inside it
+        void roundedRectRow(int x, int y, int width, int height, int radius,
+                            const int* halfWidths, int py, int& x0, int& x1) {
+            int left = x + radius;
+            int right = x + width - radius - 1;
+            int top = y + radius;
+            int bottom = y + height - radius - 1;
+            
+            // With an even size and full radius the corner centers cross
+            // over; rows and columns between them are as wide as the centers
+            int dy = py < std::min(top, bottom) ? top - py : (py > std::max(top, bottom) ? py - bottom : 0);
+            int half = halfWidths[dy];
+            
+            x0 = std::min(left - half, right);
+            x1 = std::max(right + half, left);
+        }
+        
+        struct Vec2 {
+            float x;
+            float y;
+        };
+        
+        // Miter joins longer than this many half-widths fall back to bevels
+        constexpr float kMiterLimit = 4.0f;
+        constexpr float kEdgeEpsilon = 1e-3f;
+        
+        // Widen [lo, hi] to where row y crosses a convex polygon
+        void spanConvex(const Vec2* points, int count, float y, float& lo, float& hi) {
+            for (int i = 0; i < count; ++i) {
+                const Vec2& a = points[i];
+                const Vec2& b = points[(i + 1) % count];
+                if ((y < a.y && y < b.y) || (y > a.y && y > b.y)) continue;
+                
+                if (a.y == b.y) {
+                    lo = std::min(lo, std::min(a.x, b.x));
+                    hi = std::max(hi, std::max(a.x, b.x));
+                } else {
+                    float x = a.x + (y - a.y) * (b.x - a.x) / (b.y - a.y);
+                    lo = std::min(lo, x);
+                    hi = std::max(hi, x);
+                }
+            }
+        }
+        
+        // Widen [lo, hi] to where row y crosses the disc around (cx, cy)
+        void spanDisc(int cx, int cy, const std::vector<int>& halfWidths, int y, float& lo, float& hi) {
+            size_t dy = static_cast<size_t>(std::abs(y - cy));
+            if (dy >= halfWidths.size()) return;
+            lo = std::min(lo, static_cast<float>(cx - halfWidths[dy]));
+            hi = std::max(hi, static_cast<float>(cx + halfWidths[dy]));
+        }
+        
+        // Fill the pixels of row py whose centers lie in [lo, hi]
+        void fillRowSpan(int py, float lo, float hi, uint32_t color) {
+            if (lo > hi) return;
+            fillRow(py, static_cast<int>(std::ceil(lo - kEdgeEpsilon)),
+                    static_cast<int>(std::floor(hi + kEdgeEpsilon)), color);
+        }
+        
+        void fillConvex(const Vec2* points, int count, uint32_t color) {
+            float top = points[0].y;
+            float bottom = points[0].y;
+            for (int i = 1; i < count; ++i) {
+                top = std::min(top, points[i].y);
+                bottom = std::max(bottom, points[i].y);
+            }
+            
+            const Rect& clip = globalCanvas->getClip();
+            int yStart = std::max(static_cast<int>(std::ceil(top)), clip.y);
+            int yEnd = std::min(static_cast<int>(std::floor(bottom)), clip.bottom() - 1);
+            for (int py = yStart; py <= yEnd; ++py) {
+                float lo = std::numeric_limits<float>::max();
+                float hi = std::numeric_limits<float>::lowest();
+                spanConvex(points, count, static_cast<float>(py), lo, hi);
+                fillRowSpan(py, lo, hi, color);
+            }
+        }
+        
+        // Fill every pixel within halfWidth of the segment, with round caps where
+        // asked. The shape is convex, so each row is a single span and each
+        // pixel is written once.
+        void fillSegment(int x1, int y1, int x2, int y2, int halfWidth,
+                         bool capStart, bool capEnd, uint32_t color) {
+            const Rect& clip = globalCanvas->getClip();
+            int yStart = std::max(std::min(y1, y2) - halfWidth, clip.y);
+            int yEnd = std::min(std::max(y1, y2) + halfWidth, clip.bottom() - 1);
+            if (yStart > yEnd) return;
+            
+            // Hairlines still need half a pixel of body to stay connected
+            float reach = halfWidth > 0 ? static_cast<float>(halfWidth) : 0.5f;
+            float dx = static_cast<float>(x2 - x1);
+            float dy = static_cast<float>(y2 - y1);
+            float length = std::sqrt(dx * dx + dy * dy);
+            
+            Vec2 quad[4];
+            if (length > 0.0f) {
+                float nx = -dy / length * reach;
+                float ny = dx / length * reach;
+                quad[0] = {x1 + nx, y1 + ny};
+                quad[1] = {x2 + nx, y2 + ny};
+                quad[2] = {x2 - nx, y2 - ny};
+                quad[3] = {x1 - nx, y1 - ny};
+            } else {
+                capStart = true;
+            }
+            
+            const std::vector<int>& halfWidths = discSpans.get(halfWidth);
+            for (int py = yStart; py <= yEnd; ++py) {
+                float lo = std::numeric_limits<float>::max();
+                float hi = std::numeric_limits<float>::lowest();
+                if (length > 0.0f) spanConvex(quad, 4, static_cast<float>(py), lo, hi);
+                if (capStart) spanDisc(x1, y1, halfWidths, py, lo, hi);
+                if (capEnd) spanDisc(x2, y2, halfWidths, py, lo, hi);
+                fillRowSpan(py, lo, hi, color);
+            }
+        }
+        
+        // Fill the wedge on the outside of the corner at b between segments a-b and b-c
+        void fillJoin(const Point& a, const Point& b, const Point& c, int halfWidth,
+                      Draw::LineJoin join, uint32_t color) {
+            float d1x = static_cast<float>(b.x - a.x);
+            float d1y = static_cast<float>(b.y - a.y);
+            float d2x = static_cast<float>(c.x - b.x);
+            float d2y = static_cast<float>(c.y - b.y);
+            float len1 = std::sqrt(d1x * d1x + d1y * d1y);
+            float len2 = std::sqrt(d2x * d2x + d2y * d2y);
+            if (len1 == 0.0f || len2 == 0.0f) return;
+            d1x /= len1; d1y /= len1;
+            d2x /= len2; d2y /= len2;
+            
+            float cross = d1x * d2y - d1y * d2x;
+            if (std::abs(cross) < kEdgeEpsilon) return;
+            
+            // Normals pointing to the outside of the turn
+            float side = cross > 0.0f ? -1.0f : 1.0f;
+            float reach = halfWidth > 0 ? static_cast<float>(halfWidth) : 0.5f;
+            Vec2 n1 = {-d1y * side, d1x * side};
+            Vec2 n2 = {-d2y * side, d2x * side};
+            Vec2 center = {static_cast<float>(b.x), static_cast<float>(b.y)};
+            Vec2 outer1 = {center.x + n1.x * reach, center.y + n1.y * reach};
+            Vec2 outer2 = {center.x + n2.x * reach, center.y + n2.y * reach};
+            
+            if (join == Draw::LineJoin::Miter) {
+                float mx = n1.x + n2.x;
+                float my = n1.y + n2.y;
+                float mlen = std::sqrt(mx * mx + my * my);
+                float cosHalf = mlen > 0.0f ? (mx * n1.x + my * n1.y) / mlen : 0.0f;
+                if (cosHalf * kMiterLimit > 1.0f) {
+                    float scale = reach / (cosHalf * mlen);
+                    Vec2 tip = {center.x + mx * scale, center.y + my * scale};
+                    Vec2 wedge[4] = {center, outer1, tip, outer2};
+                    fillConvex(wedge, 4, color);
+                    return;
+                }
+            }
+            
+            Vec2 bevel[3] = {center, outer1, outer2};
+            fillConvex(bevel, 3, color);
+        }
+        
+        // Inclusive pixel range; empty when lo > hi
+        struct PixelRange {
+            int lo;
+            int hi;
+        };
+        
+        constexpr int kUnbounded = std::numeric_limits<int>::max() / 4;
+        
+        // Pixels x of one row with a * x + b >= bias, as a range
+        PixelRange halfPlaneRange(float a, float b, float bias) {
+            if (std::abs(a) < kEdgeEpsilon) {
+                // Edge along the row: b is 0 on it and about 1 or more off it,
+                // so compare exactly to keep a strict bias strict
+                return b >= bias ? PixelRange{-kUnbounded, kUnbounded} : PixelRange{1, 0};
+            }
+            float bound = (bias - b) / a;
+            if (a > 0.0f) {
+                return {static_cast<int>(std::ceil(bound - kEdgeEpsilon)), kUnbounded};
+            }
+            return {-kUnbounded, static_cast<int>(std::floor(bound + kEdgeEpsilon))};
+        }
+        
+        // Pixels of row dy inside the wedge swept clockwise from direction s to
+        // direction e (at most 180 degrees). Both edges are tested as half-planes,
+        // so the wedge meets the row in one range.
+        PixelRange wedgeRange(const Vec2& s, const Vec2& e, int dy, float bias) {
+            // cross(s, p) >= 0 and cross(p, e) >= 0 with p = (x, dy)
+            PixelRange a = halfPlaneRange(-s.y, s.x * dy, bias);
+            PixelRange b = halfPlaneRange(e.y, -e.x * dy, bias);
+            return {std::max(a.lo, b.lo), std::min(a.hi, b.hi)};
+        }
+    }
+
     namespace Draw {
         void fill(uint32_t color) {
             if (!globalCanvas) return;
-            for (int i = 0; i < globalCanvas->getWidth() * globalCanvas->getHeight(); ++i) {
-                globalCanvas->getBuffer()[i] = color;
-            }
+            const Rect& clip = globalCanvas->getClip();
+            rect(clip.x, clip.y, clip.width, clip.height, color);
         }
         
         void rect(int x, int y, int width, int height, uint32_t color) {
             if (!globalCanvas) return;
+            Rect area = Rect(x, y, width, height).intersected(globalCanvas->getClip());
+            if (area.isEmpty()) return;
+            globalCanvas->addDamage(area.x, area.y, area.width, area.height);
             
-            for (int dx = 0; dx < height; ++dx) {
-                for (int dy = 0; dy < width; ++dy) {
-                    int px = x + dy;
-                    int py = y + dx;
-                    if (px >= 0 && px < globalCanvas->getWidth() && 
-                        py >= 0 && py < globalCanvas->getHeight()) {
-                        globalCanvas->getBuffer()[py * globalCanvas->getWidth() + px] = color;
-                    }
-                }
-            }
+            Span::paintRect(globalCanvas->getBuffer(), globalCanvas->getWidth(), area, color);
         }
         
         void circle(int cx, int cy, int radius, uint32_t color) {
-            if (!globalCanvas) return;
+            if (!globalCanvas || radius < 0) return;
+            Rect bounds(cx - radius, cy - radius, 2 * radius + 1, 2 * radius + 1);
+            if (!bounds.intersects(globalCanvas->getClip())) return;
+            globalCanvas->addDamage(bounds.x, bounds.y, bounds.width, bounds.height);
             
-            for (int x = -radius; x <= radius; x++) {
-                for (int y = -radius; y <= radius; y++) {
-                    if (x*x + y*y <= radius*radius) {
-                        int px = cx + x;
-                        int py = cy + y;
-                        if (px >= 0 && px < globalCanvas->getWidth() && 
-                            py >= 0 && py < globalCanvas->getHeight()) {
-                            globalCanvas->getBuffer()[py * globalCanvas->getWidth() + px] = color;
-                        }
-                    }
-                }
+            // Only walk the rows inside the clip
+            const Rect& clip = globalCanvas->getClip();
+            int dyStart = std::max(-radius, clip.y - cy);
+            int dyEnd = std::min(radius, clip.bottom() - 1 - cy);
+            
+            const std::vector<int>& halfWidths = discSpans.get(radius);
+            for (int dy = dyStart; dy <= dyEnd; ++dy) {
+                int half = halfWidths[std::abs(dy)];
+                fillRow(cy + dy, cx - half, cx + half, color);
             }
         }
         
-        void line(int x1, int y1, int x2, int y2, int thickness, uint32_t color) {
-            if (!globalCanvas) return;
+        void ring(int cx, int cy, int innerRadius, int outerRadius,
+                  float startAngle, float endAngle, uint32_t color) {
+            if (!globalCanvas || outerRadius < 0 || innerRadius >= outerRadius) return;
+            Rect bounds(cx - outerRadius, cy - outerRadius, 2 * outerRadius + 1, 2 * outerRadius + 1);
+            if (!bounds.intersects(globalCanvas->getClip())) return;
             
-            int dx = std::abs(x2 - x1);
-            int dy = std::abs(y2 - y1);
-            int sx = x1 < x2 ? 1 : -1;
-            int sy = y1 < y2 ? 1 : -1;
-            int err = dx - dy;
+            if (endAngle < startAngle) std::swap(startAngle, endAngle);
+            float sweep = endAngle - startAngle;
+            if (sweep <= 0.0f) return;
+            globalCanvas->addDamage(bounds.x, bounds.y, bounds.width, bounds.height);
             
-            while (true) {
-                circle(x1, y1, thickness, color);
+            // Arcs wider than a half turn are drawn as everything outside the
+            // wedge that is left out, which is always convex
+            bool fullTurn = sweep >= 360.0f;
+            bool wide = sweep > 180.0f;
+            float fromRadians = static_cast<float>((wide ? endAngle : startAngle) * M_PI / 180.0);
+            float toRadians = static_cast<float>((wide ? startAngle + 360.0f : endAngle) * M_PI / 180.0);
+            Vec2 from = {std::cos(fromRadians), std::sin(fromRadians)};
+            Vec2 to = {std::cos(toRadians), std::sin(toRadians)};
+            
+            // Table data pointers stay valid across the second lookup; only the
+            // least recently used table can be evicted
+            const int* outer = discSpans.get(outerRadius).data();
+            const int* inner = innerRadius >= 0 ? discSpans.get(innerRadius).data() : nullptr;
+            
+            const Rect& clip = globalCanvas->getClip();
+            int dyStart = std::max(-outerRadius, clip.y - cy);
+            int dyEnd = std::min(outerRadius, clip.bottom() - 1 - cy);
+            
+            for (int dy = dyStart; dy <= dyEnd; ++dy) {
+                int row = std::abs(dy);
+                int outerHalf = outer[row];
+                int innerHalf = inner && row <= innerRadius ? inner[row] : -1;
                 
-                if (x1 == x2 && y1 == y2) break;
+                PixelRange band[2];
+                int bandCount = 0;
+                if (innerHalf < 0) {
+                    band[bandCount++] = {-outerHalf, outerHalf};
+                } else {
+                    band[bandCount++] = {-outerHalf, -innerHalf - 1};
+                    band[bandCount++] = {innerHalf + 1, outerHalf};
+                }
                 
-                int e2 = 2 * err;
-                if (e2 > -dy) {
-                    err -= dy;
-                    x1 += sx;
+                PixelRange arc[2];
+                int arcCount = 0;
+                if (fullTurn) {
+                    arc[arcCount++] = {-kUnbounded, kUnbounded};
+                } else if (!wide) {
+                    arc[arcCount++] = wedgeRange(from, to, dy, 0.0f);
+                } else {
+                    // Strict test, so pixels on the arc's edges stay in the arc
+                    PixelRange gap = wedgeRange(from, to, dy, kEdgeEpsilon);
+                    if (gap.lo > gap.hi) {
+                        arc[arcCount++] = {-kUnbounded, kUnbounded};
+                    } else {
+                        arc[arcCount++] = {-kUnbounded, gap.lo - 1};
+                        arc[arcCount++] = {gap.hi + 1, kUnbounded};
+                    }
                 }
-                if (e2 < dx) {
-                    err += dx;
-                    y1 += sy;
+                
+                for (int i = 0; i < bandCount; ++i) {
+                    for (int j = 0; j < arcCount; ++j) {
+                        int x0 = std::max(band[i].lo, arc[j].lo);
+                        int x1 = std::min(band[i].hi, arc[j].hi);
+                        if (x0 <= x1) fillRow(cy + dy, cx + x0, cx + x1, color);
+                    }
                 }
             }
         }
         
-        void roundedRect(int x, int y, int width, int height, int radius, uint32_t color) {
-            if (!globalCanvas) return;
+        void line(int x1, int y1, int x2, int y2, int thickness, uint32_t color) {
+            if (!globalCanvas || thickness < 0) return;
+            Rect bounds(std::min(x1, x2) - thickness, std::min(y1, y2) - thickness,
+                        std::abs(x2 - x1) + 2 * thickness + 1,
+                        std::abs(y2 - y1) + 2 * thickness + 1);
+            if (!bounds.intersects(globalCanvas->getClip())) return;
             
-            // Clamp radius to not exceed half of width or height
-            radius = std::min(radius, std::min(width / 2, height / 2));
-            
-            // Draw the main rectangle (without corners)
-            rect(x + radius, y, width - 2 * radius, height, color);
-            rect(x, y + radius, radius, height - 2 * radius, color);
-            rect(x + width - radius, y + radius, radius, height - 2 * radius, color);
-            
-            // Draw rounded corners using circles
-            // Top-left corner
-            for (int dx = -radius; dx <= 0; dx++) {
-                for (int dy = -radius; dy <= 0; dy++) {
-                    if (dx*dx + dy*dy <= radius*radius) {
-                        int px = x + radius + dx;
-                        int py = y + radius + dy;
-                        if (px >= 0 && px < globalCanvas->getWidth() && 
-                            py >= 0 && py < globalCanvas->getHeight()) {
-                            globalCanvas->getBuffer()[py * globalCanvas->getWidth() + px] = color;
-                        }
-                    }
-                }
+            globalCanvas->addDamage(bounds.x, bounds.y, bounds.width, bounds.height);
+            
+            fillSegment(x1, y1, x2, y2, thickness, true, true, color);
+        }
+        
+        void polyline(const std::vector<Point>& points, int thickness, uint32_t color, LineJoin join) {
+            if (!globalCanvas || points.empty() || thickness < 0) return;
+            
+            if (points.size() == 1) {
+                circle(points[0].x, points[0].y, thickness, color);
+                return;
             }
             
-            // Top-right corner
-            for (int dx = 0; dx <= radius; dx++) {
-                for (int dy = -radius; dy <= 0; dy++) {
-                    if (dx*dx + dy*dy <= radius*radius) {
-                        int px = x + width - radius - 1 + dx;
-                        int py = y + radius + dy;
-                        if (px >= 0 && px < globalCanvas->getWidth() && 
-                            py >= 0 && py < globalCanvas->getHeight()) {
-                            globalCanvas->getBuffer()[py * globalCanvas->getWidth() + px] = color;
-                        }
-                    }
-                }
+            // Miter tips can reach past the points by up to the miter limit
+            int margin = join == LineJoin::Miter
+                ? static_cast<int>(std::ceil(std::max(thickness, 1) * kMiterLimit)) : thickness;
+            int minX = points[0].x, maxX = points[0].x;
+            int minY = points[0].y, maxY = points[0].y;
+            for (const auto& p : points) {
+                minX = std::min(minX, p.x);
+                maxX = std::max(maxX, p.x);
+                minY = std::min(minY, p.y);
+                maxY = std::max(maxY, p.y);
             }
+            Rect bounds(minX - margin, minY - margin, maxX - minX + 2 * margin + 1, maxY - minY + 2 * margin + 1);
+            if (!bounds.intersects(globalCanvas->getClip())) return;
+            globalCanvas->addDamage(bounds.x, bounds.y, bounds.width, bounds.height);
             
-            // Bottom-left corner
-            for (int dx = -radius; dx <= 0; dx++) {
-                for (int dy = 0; dy <= radius; dy++) {
-                    if (dx*dx + dy*dy <= radius*radius) {
-                        int px = x + radius + dx;
-                        int py = y + height - radius - 1 + dy;
-                        if (px >= 0 && px < globalCanvas->getWidth() && 
-                            py >= 0 && py < globalCanvas->getHeight()) {
-                            globalCanvas->getBuffer()[py * globalCanvas->getWidth() + px] = color;
-                        }
-                    }
-                }
+            // Round joins come from the start cap of each following segment
+            bool roundJoins = join == LineJoin::Round;
+            size_t last = points.size() - 1;
+            for (size_t i = 0; i < last; ++i) {
+                fillSegment(points[i].x, points[i].y, points[i + 1].x, points[i + 1].y,
+                            thickness, i == 0 || roundJoins, i + 1 == last, color);
             }
             
-            // Bottom-right corner
-            for (int dx = 0; dx <= radius; dx++) {
-                for (int dy = 0; dy <= radius; dy++) {
-                    if (dx*dx + dy*dy <= radius*radius) {
-                        int px = x + width - radius - 1 + dx;
-                        int py = y + height - radius - 1 + dy;
-                        if (px >= 0 && px < globalCanvas->getWidth() && 
-                            py >= 0 && py < globalCanvas->getHeight()) {
-                            globalCanvas->getBuffer()[py * globalCanvas->getWidth() + px] = color;
-                        }
-                    }
+            if (!roundJoins) {
+                for (size_t i = 1; i < last; ++i) {
+                    fillJoin(points[i - 1], points[i], points[i + 1], thickness, join, color);
                 }
             }
         }
         
-        void roundedRectBorder(int x, int y, int width, int height, int radius, int borderWidth, uint32_t color) {
+        void roundedRect(int x, int y, int width, int height, int radius, uint32_t color) {
             if (!globalCanvas) return;
+            if (!Rect(x, y, width, height).intersects(globalCanvas->getClip())) return;
+            
+            // Clamp radius to not exceed half of width or height
+            radius = std::max(0, std::min(radius, std::min(width / 2, height / 2)));
+            globalCanvas->addDamage(x, y, width, height);
+            
+            // Rows from the top corner centers to the bottom ones span the
+            // full width; with an even height and full radius those cross over
+            int centerTop = y + radius;
+            int centerBottom = y + height - radius - 1;
+            int middleTop = std::min(centerTop, centerBottom);
+            int middleBottom = std::max(centerTop, centerBottom);
+            
+            Rect middle = Rect(x, middleTop, width, middleBottom - middleTop + 1).intersected(globalCanvas->getClip());
+            Span::paintRect(globalCanvas->getBuffer(), globalCanvas->getWidth(), middle, color);
             
-            // Draw outer rounded rect
-            roundedRect(x, y, width, height, radius, color);
-            
-            // Draw inner rounded rect with background color to create border effect
-            // This is a simple approach - for better results we'd need a proper border algorithm
-            if (width > 2 * borderWidth && height > 2 * borderWidth) {
-                // We'll just draw the border as the difference between outer and inner rects
-                // Top border
-                rect(x + radius, y, width - 2 * radius, borderWidth, color);
-                // Bottom border  
-                rect(x + radius, y + height - borderWidth, width - 2 * radius, borderWidth, color);
-                // Left border
-                rect(x, y + radius, borderWidth, height - 2 * radius, color);
-                // Right border
-                rect(x + width - borderWidth, y + radius, borderWidth, height - 2 * radius, color);
+            // Rounded top and bottom bands, one span per row
+            const int* halfWidths = discSpans.get(radius).data();
+            for (int py = y; py < middleTop; ++py) {
+                int x0, x1;
+                roundedRectRow(x, y, width, height, radius, halfWidths, py, x0, x1);
+                fillRow(py, x0, x1, color);
+            }
+            for (int py = middleBottom + 1; py < y + height; ++py) {
+                int x0, x1;
+                roundedRectRow(x, y, width, height, radius, halfWidths, py, x0, x1);
+                fillRow(py, x0, x1, color);
+            }
+        }
+        
+        void roundedRectBorder(int x, int y, int width, int height, int radius, int borderWidth, uint32_t color) {
+            if (!globalCanvas || borderWidth <= 0) return;
+            
+            // Nothing is left inside a border this thick, so fill the whole shape
+            int innerWidth = width - 2 * borderWidth;
+            int innerHeight = height - 2 * borderWidth;
+            if (innerWidth <= 0 || innerHeight <= 0) {
+                roundedRect(x, y, width, height, radius, color);
+                return;
+            }
+            
+            Rect bounds(x, y, width, height);
+            if (!bounds.intersects(globalCanvas->getClip())) return;
+            globalCanvas->addDamage(x, y, width, height);
+            
+            // The inner edge follows the outer one, offset inward by the border width
+            radius = std::max(0, std::min(radius, std::min(width / 2, height / 2)));
+            int innerRadius = std::max(0, std::min(radius - borderWidth, std::min(innerWidth / 2, innerHeight / 2)));
+            
+            // Both tables stay valid; only the least recently used one can be evicted
+            const int* outerSpans = discSpans.get(radius).data();
+            const int* innerSpans = discSpans.get(innerRadius).data();
+            
+            const Rect& clip = globalCanvas->getClip();
+            int yStart = std::max(y, clip.y);
+            int yEnd = std::min(y + height, clip.bottom());
+            int innerTop = y + borderWidth;
+            int innerBottom = innerTop + innerHeight;
+            
+            for (int py = yStart; py < yEnd; ++py) {
+                int x0, x1;
+                roundedRectRow(x, y, width, height, radius, outerSpans, py, x0, x1);
                 
-                // Corner borders (simplified)
-                for (int i = 0; i < borderWidth; i++) {
-                    // Top-left
-                    circle(x + radius, y + radius, radius - i, color);
-                    // Top-right  
-                    circle(x + width - radius, y + radius, radius - i, color);
-                    // Bottom-left
-                    circle(x + radius, y + height - radius, radius - i, color);
-                    // Bottom-right
-                    circle(x + width - radius, y + height - radius, radius - i, color);
+                if (py < innerTop || py >= innerBottom) {
+                    fillRow(py, x0, x1, color);
+                    continue;
                 }
+                
+                // Only the band between the outer and inner edges is drawn
+                int i0, i1;
+                roundedRectRow(x + borderWidth, innerTop, innerWidth, innerHeight, innerRadius, innerSpans, py, i0, i1);
+                fillRow(py, x0, i0 - 1, color);
+                fillRow(py, i1 + 1, x1, color);
             }
         }
     }
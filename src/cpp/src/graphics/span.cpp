@@ -0,0 +1,308 @@
+#include "../../include/fern/graphics/span.hpp"
+#include <cstddef>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FERN_SPAN_SSE2 1
+#include <emmintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define FERN_SPAN_AVX2 1
+#include <immintrin.h>
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define FERN_SPAN_NEON 1
+#include <arm_neon.h>
+#elif defined(__wasm_simd128__)
+#define FERN_SPAN_WASM 1
+#include <wasm_simd128.h>
+#endif
+
+namespace Fern {
+    namespace Span {
+        namespace {
+            using FillKernel = void (*)(uint32_t*, int, uint32_t);
+            using BlendKernel = void (*)(uint32_t*, int, uint32_t, uint32_t);
+
+            // Runs shorter than this are written directly; dispatch costs more than it saves
+            constexpr int kShortSpan = 8;
+
+            inline void fillScalar(uint32_t* dst, int count, uint32_t color) {
+                for (int i = 0; i < count; ++i) {
+                    dst[i] = color;
+                }
+            }
+
+            // x / 255, rounded, exact for x <= 255 * 255
+            inline uint32_t div255(uint32_t x) {
+                x += 128;
+                return (x + (x >> 8)) >> 8;
+            }
+
+            // Scale the color channels by alpha, keeping alpha itself
+            inline uint32_t premultiply(uint32_t color) {
+                uint32_t alpha = color >> 24;
+                uint32_t r = div255(((color >> 16) & 0xFF) * alpha);
+                uint32_t g = div255(((color >> 8) & 0xFF) * alpha);
+                uint32_t b = div255((color & 0xFF) * alpha);
+                return (alpha << 24) | (r << 16) | (g << 8) | b;
+            }
+
+            // Source-over of a premultiplied source: src + dst * inverseAlpha / 255.
+            // Two channels share each multiply; every product fits in 16 bits.
+            inline uint32_t blendPixel(uint32_t dst, uint32_t premultiplied, uint32_t inverseAlpha) {
+                uint32_t rb = (dst & 0x00FF00FF) * inverseAlpha + 0x00800080;
+                uint32_t ag = ((dst >> 8) & 0x00FF00FF) * inverseAlpha + 0x00800080;
+                rb = ((rb + ((rb >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF;
+                ag = (ag + ((ag >> 8) & 0x00FF00FF)) & 0xFF00FF00;
+                return premultiplied + (rb | ag);
+            }
+
+            inline void blendScalar(uint32_t* dst, int count, uint32_t premultiplied, uint32_t inverseAlpha) {
+                for (int i = 0; i < count; ++i) {
+                    dst[i] = blendPixel(dst[i], premultiplied, inverseAlpha);
+                }
+            }
+
+#if FERN_SPAN_SSE2
+            void fillSSE2(uint32_t* dst, int count, uint32_t color) {
+                // Reach 16-byte alignment so every vector store is aligned
+                while (count > 0 && (reinterpret_cast<uintptr_t>(dst) & 15)) {
+                    *dst++ = color;
+                    --count;
+                }
+
+                __m128i v = _mm_set1_epi32(static_cast<int>(color));
+                for (; count >= 16; count -= 16, dst += 16) {
+                    _mm_store_si128(reinterpret_cast<__m128i*>(dst), v);
+                    _mm_store_si128(reinterpret_cast<__m128i*>(dst + 4), v);
+                    _mm_store_si128(reinterpret_cast<__m128i*>(dst + 8), v);
+                    _mm_store_si128(reinterpret_cast<__m128i*>(dst + 12), v);
+                }
+                for (; count >= 4; count -= 4, dst += 4) {
+                    _mm_store_si128(reinterpret_cast<__m128i*>(dst), v);
+                }
+                fillScalar(dst, count, color);
+            }
+
+            void blendSSE2(uint32_t* dst, int count, uint32_t premultiplied, uint32_t inverseAlpha) {
+                const __m128i zero = _mm_setzero_si128();
+                const __m128i src = _mm_set1_epi32(static_cast<int>(premultiplied));
+                const __m128i inv = _mm_set1_epi16(static_cast<short>(inverseAlpha));
+                const __m128i bias = _mm_set1_epi16(128);
+
+                for (; count >= 4; count -= 4, dst += 4) {
+                    __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst));
+                    __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), inv), bias);
+                    __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), inv), bias);
+                    lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+                    hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+                    d = _mm_add_epi8(_mm_packus_epi16(lo, hi), src);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), d);
+                }
+                blendScalar(dst, count, premultiplied, inverseAlpha);
+            }
+#endif
+
+#if FERN_SPAN_AVX2
+            __attribute__((target("avx2")))
+            void fillAVX2(uint32_t* dst, int count, uint32_t color) {
+                while (count > 0 && (reinterpret_cast<uintptr_t>(dst) & 31)) {
+                    *dst++ = color;
+                    --count;
+                }
+
+                __m256i v = _mm256_set1_epi32(static_cast<int>(color));
+                for (; count >= 32; count -= 32, dst += 32) {
+                    _mm256_store_si256(reinterpret_cast<__m256i*>(dst), v);
+                    _mm256_store_si256(reinterpret_cast<__m256i*>(dst + 8), v);
+                    _mm256_store_si256(reinterpret_cast<__m256i*>(dst + 16), v);
+                    _mm256_store_si256(reinterpret_cast<__m256i*>(dst + 24), v);
+                }
+                for (; count >= 8; count -= 8, dst += 8) {
+                    _mm256_store_si256(reinterpret_cast<__m256i*>(dst), v);
+                }
+                fillScalar(dst, count, color);
+            }
+
+            __attribute__((target("avx2")))
+            void blendAVX2(uint32_t* dst, int count, uint32_t premultiplied, uint32_t inverseAlpha) {
+                const __m256i zero = _mm256_setzero_si256();
+                const __m256i src = _mm256_set1_epi32(static_cast<int>(premultiplied));
+                const __m256i inv = _mm256_set1_epi16(static_cast<short>(inverseAlpha));
+                const __m256i bias = _mm256_set1_epi16(128);
+
+                // Unpack and pack both work within 128-bit lanes, so pixel order is kept
+                for (; count >= 8; count -= 8, dst += 8) {
+                    __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst));
+                    __m256i lo = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(d, zero), inv), bias);
+                    __m256i hi = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(d, zero), inv), bias);
+                    lo = _mm256_srli_epi16(_mm256_add_epi16(lo, _mm256_srli_epi16(lo, 8)), 8);
+                    hi = _mm256_srli_epi16(_mm256_add_epi16(hi, _mm256_srli_epi16(hi, 8)), 8);
+                    d = _mm256_add_epi8(_mm256_packus_epi16(lo, hi), src);
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), d);
+                }
+                blendScalar(dst, count, premultiplied, inverseAlpha);
+            }
+#endif
+
+#if FERN_SPAN_NEON
+            void fillNEON(uint32_t* dst, int count, uint32_t color) {
+                uint32x4_t v = vdupq_n_u32(color);
+                for (; count >= 16; count -= 16, dst += 16) {
+                    vst1q_u32(dst, v);
+                    vst1q_u32(dst + 4, v);
+                    vst1q_u32(dst + 8, v);
+                    vst1q_u32(dst + 12, v);
+                }
+                for (; count >= 4; count -= 4, dst += 4) {
+                    vst1q_u32(dst, v);
+                }
+                fillScalar(dst, count, color);
+            }
+
+            void blendNEON(uint32_t* dst, int count, uint32_t premultiplied, uint32_t inverseAlpha) {
+                const uint8x16_t src = vreinterpretq_u8_u32(vdupq_n_u32(premultiplied));
+                const uint8x8_t inv = vdup_n_u8(static_cast<uint8_t>(inverseAlpha));
+
+                for (; count >= 4; count -= 4, dst += 4) {
+                    uint8x16_t d = vreinterpretq_u8_u32(vld1q_u32(dst));
+                    uint16x8_t lo = vmull_u8(vget_low_u8(d), inv);
+                    uint16x8_t hi = vmull_u8(vget_high_u8(d), inv);
+                    // (x + ((x + 128) >> 8) + 128) >> 8, the same rounding as div255()
+                    uint8x8_t lo8 = vrshrn_n_u16(vrsraq_n_u16(lo, lo, 8), 8);
+                    uint8x8_t hi8 = vrshrn_n_u16(vrsraq_n_u16(hi, hi, 8), 8);
+                    d = vaddq_u8(vcombine_u8(lo8, hi8), src);
+                    vst1q_u32(dst, vreinterpretq_u32_u8(d));
+                }
+                blendScalar(dst, count, premultiplied, inverseAlpha);
+            }
+#endif
+
+#if FERN_SPAN_WASM
+            void fillSIMD128(uint32_t* dst, int count, uint32_t color) {
+                v128_t v = wasm_i32x4_splat(static_cast<int32_t>(color));
+                for (; count >= 16; count -= 16, dst += 16) {
+                    wasm_v128_store(dst, v);
+                    wasm_v128_store(dst + 4, v);
+                    wasm_v128_store(dst + 8, v);
+                    wasm_v128_store(dst + 12, v);
+                }
+                for (; count >= 4; count -= 4, dst += 4) {
+                    wasm_v128_store(dst, v);
+                }
+                fillScalar(dst, count, color);
+            }
+
+            void blendSIMD128(uint32_t* dst, int count, uint32_t premultiplied, uint32_t inverseAlpha) {
+                const v128_t src = wasm_i32x4_splat(static_cast<int32_t>(premultiplied));
+                const v128_t inv = wasm_i16x8_splat(static_cast<int16_t>(inverseAlpha));
+                const v128_t bias = wasm_i16x8_splat(128);
+
+                for (; count >= 4; count -= 4, dst += 4) {
+                    v128_t d = wasm_v128_load(dst);
+                    v128_t lo = wasm_i16x8_add(wasm_i16x8_mul(wasm_u16x8_extend_low_u8x16(d), inv), bias);
+                    v128_t hi = wasm_i16x8_add(wasm_i16x8_mul(wasm_u16x8_extend_high_u8x16(d), inv), bias);
+                    lo = wasm_u16x8_shr(wasm_i16x8_add(lo, wasm_u16x8_shr(lo, 8)), 8);
+                    hi = wasm_u16x8_shr(wasm_i16x8_add(hi, wasm_u16x8_shr(hi, 8)), 8);
+                    d = wasm_i8x16_add(wasm_u8x16_narrow_i16x8(lo, hi), src);
+                    wasm_v128_store(dst, d);
+                }
+                blendScalar(dst, count, premultiplied, inverseAlpha);
+            }
+#endif
+
+            struct Kernel {
+                FillKernel fill;
+                BlendKernel blend;
+                const char* name;
+            };
+
+            Kernel selectKernel() {
+#if FERN_SPAN_AVX2
+                __builtin_cpu_init();
+                if (__builtin_cpu_supports("avx2")) {
+                    return {fillAVX2, blendAVX2, "avx2"};
+                }
+#endif
+#if FERN_SPAN_SSE2
+                return {fillSSE2, blendSSE2, "sse2"};
+#elif FERN_SPAN_NEON
+                return {fillNEON, blendNEON, "neon"};
+#elif FERN_SPAN_WASM
+                return {fillSIMD128, blendSIMD128, "simd128"};
+#else
+                return {fillScalar, blendScalar, "scalar"};
+#endif
+            }
+
+            const Kernel& kernel() {
+                static const Kernel selected = selectKernel();
+                return selected;
+            }
+        }
+
+        void fill(uint32_t* dst, int count, uint32_t color) {
+            if (count < kShortSpan) {
+                fillScalar(dst, count, color);
+                return;
+            }
+            kernel().fill(dst, count, color);
+        }
+
+        void fillRect(uint32_t* buffer, int stride, const Rect& rect, uint32_t color) {
+            if (rect.isEmpty()) return;
+
+            uint32_t* row = buffer + static_cast<size_t>(rect.y) * stride + rect.x;
+            if (rect.width == stride) {
+                fill(row, rect.width * rect.height, color);
+                return;
+            }
+
+            for (int i = 0; i < rect.height; ++i, row += stride) {
+                fill(row, rect.width, color);
+            }
+        }
+
+        void blend(uint32_t* dst, int count, uint32_t color) {
+            if (count <= 0) return;
+            uint32_t premultiplied = premultiply(color);
+            uint32_t inverseAlpha = 255 - (color >> 24);
+            if (count < kShortSpan) {
+                blendScalar(dst, count, premultiplied, inverseAlpha);
+                return;
+            }
+            kernel().blend(dst, count, premultiplied, inverseAlpha);
+        }
+
+        void blendMask(uint32_t* dst, const uint8_t* coverage, int count, uint32_t color) {
+            uint32_t alpha = color >> 24;
+            uint32_t rgb = color & 0x00FFFFFF;
+            for (int i = 0; i < count; ++i) {
+                uint32_t a = div255(alpha * coverage[i]);
+                if (a == 0) continue;
+                if (a == 0xFF) {
+                    dst[i] = color;
+                } else {
+                    dst[i] = blendPixel(dst[i], premultiply((a << 24) | rgb), 255 - a);
+                }
+            }
+        }
+
+        void paintRect(uint32_t* buffer, int stride, const Rect& rect, uint32_t color) {
+            uint32_t alpha = color >> 24;
+            if (alpha == 0xFF) {
+                fillRect(buffer, stride, rect, color);
+                return;
+            }
+            if (alpha == 0 || rect.isEmpty()) return;
+
+            uint32_t* row = buffer + static_cast<size_t>(rect.y) * stride + rect.x;
+            for (int i = 0; i < rect.height; ++i, row += stride) {
+                blend(row, rect.width, color);
+            }
+        }
+
+        const char* kernelName() {
+            return kernel().name;
+        }
+    }
+}
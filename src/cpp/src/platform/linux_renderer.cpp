@@ -3,11 +3,31 @@
 #include <X11/Xlib.h>
 #include <X11/Xutil.h>
 #include <X11/keysym.h>
+#ifdef FERN_X11_SHM
+#include <X11/extensions/XShm.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#endif
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
 #include <iostream>
 #include <cstring>
 
 namespace Fern {
     
+#ifdef FERN_X11_SHM
+    namespace {
+        // XShmAttach reports failure (e.g. on a remote display) as an X error
+        bool shmAttachFailed = false;
+        
+        int onShmAttachError(Display*, XErrorEvent*) {
+            shmAttachFailed = true;
+            return 0;
+        }
+    }
+#endif
+    
     class LinuxRenderer : public PlatformRenderer {
     private:
         // Core X11 components
@@ -15,11 +35,19 @@ namespace Fern {
         Window window_;             // Our application window
         GC gc_;                     // Graphics context for drawing
         XImage* ximage_;            // Image structure for pixel data
-        uint32_t* pixelBuffer_;     // Our local pixel buffer
+        uint32_t* pixelBuffer_;     // Pixels behind ximage_, drawn into by the canvas
         int width_, height_;        // Window dimensions
+        bool useShm_;               // Present through MIT-SHM shared memory
+#ifdef FERN_X11_SHM
+        XShmSegmentInfo shmInfo_;   // Segment holding pixelBuffer_ when useShm_
+        int shmCompletionEvent_;    // Event type sent when the server has read the segment
+        int shmPending_;            // Uploads the server may still be reading from
+#endif
         bool shouldClose_;          // Application running state
         Atom wmDeleteMessage_;      // Window manager delete message
         
+        int wakePipe_[2];           // Written by wake() to interrupt waitEvents()
+        
         XIM xim_;                   // Input Method
         XIC xic_;                   // Input Context
         Atom wmTakeFocus_;
@@ -84,7 +112,13 @@ namespace Fern {
         
     public:
         LinuxRenderer() : display_(nullptr), window_(0), gc_(nullptr), 
-                         ximage_(nullptr), pixelBuffer_(nullptr), shouldClose_(false) {
+                         ximage_(nullptr), pixelBuffer_(nullptr), useShm_(false),
+                         shouldClose_(false), wakePipe_{-1, -1} {
+#ifdef FERN_X11_SHM
+            shmInfo_ = XShmSegmentInfo();
+            shmCompletionEvent_ = 0;
+            shmPending_ = 0;
+#endif
         }
         
         ~LinuxRenderer() {
@@ -144,8 +178,21 @@ namespace Fern {
                 throw std::runtime_error("Failed to create graphics context");
             }
             
+#ifdef FERN_X11_SHM
+            useShm_ = XShmQueryExtension(display_);
+            if (useShm_) {
+                shmCompletionEvent_ = XShmGetEventBase(display_) + ShmCompletion;
+            }
+#endif
             setupPixelBuffer();
             
+            if (pipe(wakePipe_) == 0) {
+                fcntl(wakePipe_[0], F_SETFL, O_NONBLOCK);
+                fcntl(wakePipe_[1], F_SETFL, O_NONBLOCK);
+            } else {
+                wakePipe_[0] = wakePipe_[1] = -1;
+            }
+            
             XMapWindow(display_, window_);
 
             bool windowIsReady = false;
@@ -161,8 +208,9 @@ namespace Fern {
             XFlush(display_);
         }
         
-        void present(uint32_t* pixelBuffer, int width, int height) override {
-            if (!ximage_ || !pixelBuffer_ || !display_ || !pixelBuffer) {
+        void present(uint32_t* pixelBuffer, int width, int height,
+                     const std::vector<Rect>& damage) override {
+            if (!ximage_ || !display_ || !pixelBuffer) {
                 return;
             }
             
@@ -170,13 +218,27 @@ namespace Fern {
                 return; 
             }
             
-            size_t bufferSize = width * height * sizeof(uint32_t);
-            memcpy(pixelBuffer_, pixelBuffer, bufferSize);
+            if (damage.empty()) {
+                return;
+            }
             
-            XPutImage(
-                display_, window_, gc_, ximage_,
-                0, 0, 0, 0, width, height
-            );
+            // A canvas drawing into getPixelBuffer() needs no copy; any other
+            // buffer has its changed rows copied into ours first
+            bool copy = pixelBuffer != pixelBuffer_;
+            Rect bounds(0, 0, width, height);
+            for (const Rect& damaged : damage) {
+                Rect rect = damaged.intersected(bounds);
+                if (rect.isEmpty()) continue;
+                
+                if (copy) {
+                    for (int row = rect.y; row < rect.bottom(); ++row) {
+                        size_t offset = static_cast<size_t>(row) * width + rect.x;
+                        memcpy(pixelBuffer_ + offset, pixelBuffer + offset, rect.width * sizeof(uint32_t));
+                    }
+                }
+                
+                putImage(rect);
+            }
             
             XFlush(display_);
         }
@@ -192,6 +254,40 @@ namespace Fern {
             return shouldClose_;
         }
         
+        bool waitEvents(int timeoutMs) override {
+            if (!display_) return true;
+            
+            // Completions for the last present would otherwise wake us at once
+            waitForShmCompletion();
+            
+            // XPending flushes our requests and reads what the server already sent
+            if (XPending(display_) > 0) return true;
+            
+            pollfd fds[2] = {
+                {ConnectionNumber(display_), POLLIN, 0},
+                {wakePipe_[0], POLLIN, 0}
+            };
+            int count = wakePipe_[0] >= 0 ? 2 : 1;
+            if (poll(fds, count, timeoutMs) <= 0) return false;
+            
+            if (count == 2 && (fds[1].revents & POLLIN)) {
+                char drain[64];
+                while (read(wakePipe_[0], drain, sizeof(drain)) > 0) {}
+            }
+            return (fds[0].revents & POLLIN) && XPending(display_) > 0;
+        }
+        
+        void wake() override {
+            if (wakePipe_[1] >= 0) {
+                char byte = 0;
+                (void)!write(wakePipe_[1], &byte, 1);
+            }
+        }
+        
+        uint32_t* getPixelBuffer() override {
+            return pixelBuffer_;
+        }
+        
         void pollEvents() override {
             XEvent event;
             while (XPending(display_) > 0) {
@@ -199,6 +295,12 @@ namespace Fern {
                 if (XFilterEvent(&event, None)) {
                     continue;
                 }
+#ifdef FERN_X11_SHM
+                if (useShm_ && event.type == shmCompletionEvent_) {
+                    --shmPending_;
+                    continue;
+                }
+#endif
                 
                 switch (event.type) {
                     case ButtonPress:
@@ -265,6 +367,18 @@ namespace Fern {
                         }
                         break;
                         
+                    case Expose: {
+                        // Our copy still holds the last presented frame, so
+                        // repaint the exposed area without waiting for a redraw
+                        Rect exposed = Rect(event.xexpose.x, event.xexpose.y,
+                                            event.xexpose.width, event.xexpose.height)
+                                           .intersected(Rect(0, 0, width_, height_));
+                        if (ximage_ && !exposed.isEmpty()) {
+                            putImage(exposed);
+                        }
+                        break;
+                    }
+                        
                     case FocusIn:
                         break;
                         
@@ -275,6 +389,9 @@ namespace Fern {
                         break;
                 }
             }
+            
+            // The caller draws the next frame into pixelBuffer_ after this
+            waitForShmCompletion();
         }
         
         std::string getPlatformName() override {
@@ -305,76 +422,173 @@ namespace Fern {
                 throw std::runtime_error("Invalid window dimensions for pixel buffer");
             }
             
+            if (!createImage(width_, height_)) {
+                throw std::runtime_error("Failed to create XImage");
+            }
+        }
+        
+        void resizePixelBuffer(int newWidth, int newHeight) {
+            if (newWidth <= 0 || newHeight <= 0) return;
+            
+            destroyImage();
+            if (!createImage(newWidth, newHeight)) {
+                std::cerr << "Error: Failed to create resized XImage" << std::endl;
+            }
+        }
+        
+        // Create ximage_ and pixelBuffer_, in shared memory when the server allows it
+        bool createImage(int width, int height) {
+#ifdef FERN_X11_SHM
+            if (useShm_ && createShmImage(width, height)) {
+                return true;
+            }
+            useShm_ = false;
+#endif
+            return createLocalImage(width, height);
+        }
+        
+        bool createLocalImage(int width, int height) {
             try {
-                pixelBuffer_ = new uint32_t[width_ * height_];
-                memset(pixelBuffer_, 0, width_ * height_ * sizeof(uint32_t));
+                pixelBuffer_ = new uint32_t[static_cast<size_t>(width) * height];
+                memset(pixelBuffer_, 0, static_cast<size_t>(width) * height * sizeof(uint32_t));
             } catch (const std::bad_alloc& e) {
-                throw std::runtime_error("Failed to allocate pixel buffer: " + std::string(e.what()));
+                std::cerr << "Error: Failed to allocate pixel buffer: " << e.what() << std::endl;
+                pixelBuffer_ = nullptr;
+                return false;
             }
             
             int screen = DefaultScreen(display_);
             ximage_ = XCreateImage(
                 display_, DefaultVisual(display_, screen), DefaultDepth(display_, screen),
-                ZPixmap, 0, (char*)pixelBuffer_, width_, height_, 32, 0
+                ZPixmap, 0, (char*)pixelBuffer_, width, height, 32, 0
             );
             
             if (!ximage_) {
                 delete[] pixelBuffer_;
                 pixelBuffer_ = nullptr;
-                throw std::runtime_error("Failed to create XImage");
+                return false;
             }
+            return true;
         }
         
-        void resizePixelBuffer(int newWidth, int newHeight) {
-            if (newWidth <= 0 || newHeight <= 0) return;
+#ifdef FERN_X11_SHM
+        bool createShmImage(int width, int height) {
+            int screen = DefaultScreen(display_);
+            ximage_ = XShmCreateImage(
+                display_, DefaultVisual(display_, screen), DefaultDepth(display_, screen),
+                ZPixmap, nullptr, &shmInfo_, width, height
+            );
+            if (!ximage_) return false;
             
-            XImage* oldXImage = ximage_;
-            uint32_t* oldPixelBuffer = pixelBuffer_;
+            // The canvas draws into the segment, so rows must be packed 32-bit pixels
+            if (ximage_->bits_per_pixel != 32 || ximage_->bytes_per_line != width * 4) {
+                XDestroyImage(ximage_);
+                ximage_ = nullptr;
+                return false;
+            }
             
-            try {
-                pixelBuffer_ = new uint32_t[newWidth * newHeight];
-            } catch (const std::bad_alloc& e) {
-                std::cerr << "Error: Failed to allocate new pixel buffer: " << e.what() << std::endl;
-                pixelBuffer_ = oldPixelBuffer;
-                return;
+            size_t bytes = static_cast<size_t>(ximage_->bytes_per_line) * height;
+            shmInfo_.shmid = shmget(IPC_PRIVATE, bytes, IPC_CREAT | 0600);
+            if (shmInfo_.shmid < 0) {
+                XDestroyImage(ximage_);
+                ximage_ = nullptr;
+                return false;
             }
             
-            int screen = DefaultScreen(display_);
-            ximage_ = XCreateImage(
-                display_, DefaultVisual(display_, screen), DefaultDepth(display_, screen),
-                ZPixmap, 0, (char*)pixelBuffer_, newWidth, newHeight, 32, 0
-            );
+            shmInfo_.shmaddr = static_cast<char*>(shmat(shmInfo_.shmid, nullptr, 0));
+            if (shmInfo_.shmaddr == reinterpret_cast<char*>(-1)) {
+                shmctl(shmInfo_.shmid, IPC_RMID, nullptr);
+                XDestroyImage(ximage_);
+                ximage_ = nullptr;
+                return false;
+            }
+            ximage_->data = shmInfo_.shmaddr;
+            shmInfo_.readOnly = False;
             
-            if (!ximage_) {
-                std::cerr << "Error: Failed to create resized XImage" << std::endl;
-                delete[] pixelBuffer_;
-                pixelBuffer_ = oldPixelBuffer;
-                ximage_ = oldXImage;
-                return;
+            XSync(display_, False);
+            shmAttachFailed = false;
+            XErrorHandler previousHandler = XSetErrorHandler(onShmAttachError);
+            Bool attached = XShmAttach(display_, &shmInfo_);
+            XSync(display_, False);
+            XSetErrorHandler(previousHandler);
+            
+            // Marked for removal now, the segment is freed once both sides detach
+            shmctl(shmInfo_.shmid, IPC_RMID, nullptr);
+            
+            if (!attached || shmAttachFailed) {
+                shmdt(shmInfo_.shmaddr);
+                ximage_->data = nullptr;
+                XDestroyImage(ximage_);
+                ximage_ = nullptr;
+                return false;
             }
             
-            if (oldXImage) {
-                oldXImage->data = nullptr;
-                XDestroyImage(oldXImage);
+            pixelBuffer_ = reinterpret_cast<uint32_t*>(shmInfo_.shmaddr);
+            memset(pixelBuffer_, 0, bytes);
+            return true;
+        }
+        
+        static Bool isShmCompletion(Display*, XEvent* event, XPointer renderer) {
+            return event->type == reinterpret_cast<LinuxRenderer*>(renderer)->shmCompletionEvent_;
+        }
+#endif
+        
+        // Block until the server has finished reading every uploaded segment
+        void waitForShmCompletion() {
+#ifdef FERN_X11_SHM
+            while (shmPending_ > 0) {
+                XEvent event;
+                XIfEvent(display_, &event, isShmCompletion, reinterpret_cast<XPointer>(this));
+                --shmPending_;
             }
-            if (oldPixelBuffer) {
-                delete[] oldPixelBuffer;
+#endif
+        }
+        
+        void putImage(const Rect& rect) {
+#ifdef FERN_X11_SHM
+            if (useShm_) {
+                // The server reads the segment later; the completion event says when
+                XShmPutImage(display_, window_, gc_, ximage_,
+                             rect.x, rect.y, rect.x, rect.y, rect.width, rect.height, True);
+                ++shmPending_;
+                return;
             }
+#endif
+            XPutImage(display_, window_, gc_, ximage_,
+                      rect.x, rect.y, rect.x, rect.y, rect.width, rect.height);
         }
         
-        void cleanup() {
-            if (xic_) { XDestroyIC(xic_); xic_ = nullptr; }
-            if (xim_) { XCloseIM(xim_); xim_ = nullptr; }
+        void destroyImage() {
+            if (!ximage_) return;
             
-            if (ximage_) {
+#ifdef FERN_X11_SHM
+            if (useShm_) {
+                waitForShmCompletion();
+                XShmDetach(display_, &shmInfo_);
+                XSync(display_, False);
                 ximage_->data = nullptr;
                 XDestroyImage(ximage_);
+                shmdt(shmInfo_.shmaddr);
                 ximage_ = nullptr;
+                pixelBuffer_ = nullptr;
+                return;
             }
+#endif
+            ximage_->data = nullptr;
+            XDestroyImage(ximage_);
+            ximage_ = nullptr;
+            delete[] pixelBuffer_;
+            pixelBuffer_ = nullptr;
+        }
+        
+        void cleanup() {
+            if (xic_) { XDestroyIC(xic_); xic_ = nullptr; }
+            if (xim_) { XCloseIM(xim_); xim_ = nullptr; }
             
-            if (pixelBuffer_) {
-                delete[] pixelBuffer_;
-                pixelBuffer_ = nullptr;
+            destroyImage();
+            
+            for (int& fd : wakePipe_) {
+                if (fd >= 0) { close(fd); fd = -1; }
             }
             
             if (gc_) {
@@ -11,6 +11,7 @@
     int bufferHeight;
 }
 - (void)setPixelBuffer:(uint32_t*)buffer width:(int)w height:(int)h;
+- (void)invalidatePixelRectX:(int)x y:(int)y width:(int)w height:(int)h;
 @end
 
 @implementation FernView
@@ -29,7 +30,19 @@
     pixelBuffer = buffer;
     bufferWidth = w;
     bufferHeight = h;
-    [self setNeedsDisplay:YES];
+}
+
+- (void)invalidatePixelRectX:(int)x y:(int)y width:(int)w height:(int)h {
+    if (bufferWidth == 0 || bufferHeight == 0) {
+        return;
+    }
+    
+    // Buffer rows run top-down while the view's origin is bottom-left
+    NSRect bounds = self.bounds;
+    CGFloat scaleX = bounds.size.width / bufferWidth;
+    CGFloat scaleY = bounds.size.height / bufferHeight;
+    [self setNeedsDisplayInRect:NSMakeRect(x * scaleX, (bufferHeight - y - h) * scaleY,
+                                           w * scaleX, h * scaleY)];
 }
 
 - (void)drawRect:(NSRect)dirtyRect {
@@ -253,7 +266,8 @@ namespace Fern {
             }];
         }
         
-        void present(uint32_t* pixelBuffer, int width, int height) override {
+        void present(uint32_t* pixelBuffer, int width, int height,
+                     const std::vector<Rect>& damage) override {
             @autoreleasepool {
                 if (width != width_ || height != height_) {
                     // Resize buffer if needed
@@ -261,13 +275,31 @@ namespace Fern {
                     pixelBuffer_ = new uint32_t[width * height];
                     width_ = width;
                     height_ = height;
+                    
+                    std::memcpy(pixelBuffer_, pixelBuffer, width * height * sizeof(uint32_t));
+                    [view_ setPixelBuffer:pixelBuffer_ width:width height:height];
+                    [view_ setNeedsDisplay:YES];
+                    return;
                 }
                 
-                // Copy pixel data
-                std::memcpy(pixelBuffer_, pixelBuffer, width * height * sizeof(uint32_t));
+                if (damage.empty()) {
+                    return;
+                }
                 
-                // Update view
                 [view_ setPixelBuffer:pixelBuffer_ width:width height:height];
+                
+                // Copy only the damaged rows and redraw just those parts of the view
+                Rect bounds(0, 0, width, height);
+                for (const Rect& damaged : damage) {
+                    Rect rect = damaged.intersected(bounds);
+                    if (rect.isEmpty()) continue;
+                    
+                    for (int row = rect.y; row < rect.bottom(); ++row) {
+                        size_t offset = static_cast<size_t>(row) * width + rect.x;
+                        std::memcpy(pixelBuffer_ + offset, pixelBuffer + offset, rect.width * sizeof(uint32_t));
+                    }
+                    [view_ invalidatePixelRectX:rect.x y:rect.y width:rect.width height:rect.height];
+                }
             }
         }
         
@@ -320,6 +352,35 @@ namespace Fern {
             return shouldClose_;
         }
         
+        bool waitEvents(int timeoutMs) override {
+            @autoreleasepool {
+                NSDate* until = timeoutMs < 0
+                    ? [NSDate distantFuture]
+                    : [NSDate dateWithTimeIntervalSinceNow:timeoutMs / 1000.0];
+                NSEvent* event = [NSApp nextEventMatchingMask:NSEventMaskAny
+                                                    untilDate:until
+                                                       inMode:NSDefaultRunLoopMode
+                                                      dequeue:NO];
+                return event != nil;
+            }
+        }
+        
+        void wake() override {
+            @autoreleasepool {
+                // postEvent: is safe from other threads and ends the wait above
+                NSEvent* event = [NSEvent otherEventWithType:NSEventTypeApplicationDefined
+                                                    location:NSZeroPoint
+                                               modifierFlags:0
+                                                   timestamp:0
+                                                windowNumber:0
+                                                     context:nil
+                                                     subtype:0
+                                                       data1:0
+                                                       data2:0];
+                [NSApp postEvent:event atStart:NO];
+            }
+        }
+        
         void pollEvents() override {
             @autoreleasepool {
                 NSEvent* event;
@@ -38,31 +38,48 @@ namespace Fern {
             setupEventListeners();
         }
         
-        void present(uint32_t* pixelBuffer, int width, int height) override {
+        void present(uint32_t* pixelBuffer, int width, int height,
+                     const std::vector<Rect>& damage) override {
+            if (damage.empty()) {
+                return;
+            }
+            
             EM_ASM({
                 var canvas = document.getElementById('canvas');
                 var ctx = canvas.getContext('2d');
                 
-                var imageData = ctx.createImageData($0, $1);
+                // Keep one ImageData alive between frames so only damaged
+                // pixels need converting
+                var imageData = canvas.fernImageData;
+                if (!imageData || imageData.width !== $0 || imageData.height !== $1) {
+                    imageData = ctx.createImageData($0, $1);
+                    canvas.fernImageData = imageData;
+                }
                 var data = imageData.data;
                 var buffer = $2;
-                var size = $0 * $1;
+                var rects = $3 >> 2;
                 
-                for (var i = 0; i < size; i++) {
-                    var pixel = HEAP32[buffer/4 + i];
-                    var b = pixel & 0xFF;
-                    var g = (pixel >> 8) & 0xFF;
-                    var r = (pixel >> 16) & 0xFF;
-                    var a = (pixel >> 24) & 0xFF;
-                    var j = i * 4;
-                    data[j + 0] = r;
-                    data[j + 1] = g;
-                    data[j + 2] = b;
-                    data[j + 3] = a;
+                for (var r = 0; r < $4; r++) {
+                    var rx = HEAP32[rects + r * 4];
+                    var ry = HEAP32[rects + r * 4 + 1];
+                    var rw = HEAP32[rects + r * 4 + 2];
+                    var rh = HEAP32[rects + r * 4 + 3];
+                    
+                    for (var y = ry; y < ry + rh; y++) {
+                        for (var x = rx; x < rx + rw; x++) {
+                            var i = y * $0 + x;
+                            var pixel = HEAP32[buffer/4 + i];
+                            var j = i * 4;
+                            data[j + 0] = (pixel >> 16) & 0xFF;
+                            data[j + 1] = (pixel >> 8) & 0xFF;
+                            data[j + 2] = pixel & 0xFF;
+                            data[j + 3] = (pixel >> 24) & 0xFF;
+                        }
+                    }
+                    
+                    ctx.putImageData(imageData, 0, 0, rx, ry, rw, rh);
                 }
-                
-                ctx.putImageData(imageData, 0, 0);
-            }, width, height, pixelBuffer);
+            }, width, height, pixelBuffer, damage.data(), static_cast<int>(damage.size()));
         }
         
         void setTitle(const std::string& title) override {
@@ -1,96 +1,182 @@
 #include "../../include/fern/text/font.hpp"
 #include "../../include/fern/core/canvas.hpp"
+#include "../../include/fern/graphics/span.hpp"
 #include "font_data.hpp"
-#include <cstring>
+#include <vector>
 
 namespace Fern {
     namespace DrawText {
-        void drawChar(char c, int x, int y, int scale, uint32_t color) {
-            if (!globalCanvas) return;
+        namespace {
+            constexpr int kGlyphCount = 72;
+            constexpr int kCellCount = 8;      // Glyphs are 8x8 cells
+            constexpr int kSpaceCells = 4;     // Advance of spaces and unknown characters
             
-            int char_index = -1;
+            // Byte -> SIMPLE_FONT index, -1 for characters the font lacks.
+            // Built at compile time so no character-class branches remain.
+            struct GlyphMap {
+                int8_t index[256];
+            };
             
-            if (c >= 'A' && c <= 'Z') {
-                char_index = c - 'A';  // 0-25 (A-Z)
-            } else if (c >= '0' && c <= '9') {
-                char_index = 26 + (c - '0');  // 26-35 (0-9)
-            } else if (c >= 'a' && c <= 'z') {
-                char_index = 36 + (c - 'a');  // 36-61 (a-z)
-            } else {
-                // Handle special symbols
-                switch (c) {
-                    case '+': char_index = 62; break;  // +
-                    case '-': char_index = 63; break;  // -
-                    case '*': char_index = 64; break;  // × (multiply) - map * to ×
-                    case '/': char_index = 65; break;  // ÷ (divide) - map / to ÷
-                    case '=': char_index = 66; break;  // =
-                    case '(': char_index = 67; break;  // (
-                    case ')': char_index = 68; break;  // )
-                    case '.': char_index = 69; break;  // .
-                    case '!': char_index = 70; break;  // !
-                    default: return; // Unsupported character
+            constexpr GlyphMap buildGlyphMap() {
+                GlyphMap map{};
+                for (int c = 0; c < 256; c++) map.index[c] = -1;
+                for (int c = 'A'; c <= 'Z'; c++) map.index[c] = static_cast<int8_t>(c - 'A');       // 0-25
+                for (int c = '0'; c <= '9'; c++) map.index[c] = static_cast<int8_t>(26 + c - '0');  // 26-35
+                for (int c = 'a'; c <= 'z'; c++) map.index[c] = static_cast<int8_t>(36 + c - 'a');  // 36-61
+                const char symbols[] = "+-*/=().!";  // * and / are drawn as × and ÷
+                for (int i = 0; symbols[i]; i++) {
+                    map.index[static_cast<unsigned char>(symbols[i])] = static_cast<int8_t>(62 + i);
                 }
+                return map;
             }
             
-            if (char_index == -1) return;
+            constexpr GlyphMap kGlyphMap = buildGlyphMap();
+            
+            // A block of lit cells: one run of set bits, merged with the same
+            // run in the rows below it. Scaling is a multiply, so one list
+            // serves every scale.
+            struct CellRect {
+                uint8_t x0, x1, y0, y1;
+            };
             
-            for (int row = 0; row < 8; row++) {
-                unsigned char row_bits = FontData::SIMPLE_FONT[char_index][row];
+            struct GlyphRects {
+                std::vector<CellRect> rects;
+                uint16_t first[kGlyphCount + 1];
                 
-                for (int col = 0; col < 8; col++) {
-                    if (row_bits & (1 << (7 - col))) {
-                        int base_x = x + col * scale;
-                        int base_y = y + row * scale;
-                        
-                        for (int sy = 0; sy < scale; sy++) {
-                            for (int sx = 0; sx < scale; sx++) {
-                                int px = base_x + sx;
-                                int py = base_y + sy;
-                                
-                                if (px >= 0 && px < globalCanvas->getWidth() && 
-                                    py >= 0 && py < globalCanvas->getHeight()) {
-                                    globalCanvas->getBuffer()[py * globalCanvas->getWidth() + px] = color;
-                                }
+                GlyphRects() {
+                    for (int glyph = 0; glyph < kGlyphCount; glyph++) {
+                        first[glyph] = static_cast<uint16_t>(rects.size());
+                        for (uint8_t row = 0; row < kCellCount; row++) {
+                            unsigned char bits = FontData::SIMPLE_FONT[glyph][row];
+                            for (uint8_t col = 0; col < kCellCount; col++) {
+                                if (!(bits & (0x80 >> col))) continue;
+                                uint8_t end = col + 1;
+                                while (end < kCellCount && (bits & (0x80 >> end))) end++;
+                                addRun(glyph, col, end, row);
+                                col = end;
                             }
                         }
                     }
+                    first[kGlyphCount] = static_cast<uint16_t>(rects.size());
+                }
+                
+                void addRun(int glyph, uint8_t x0, uint8_t x1, uint8_t row) {
+                    for (size_t i = first[glyph]; i < rects.size(); i++) {
+                        CellRect& rect = rects[i];
+                        if (rect.y1 == row && rect.x0 == x0 && rect.x1 == x1) {
+                            rect.y1 = row + 1;
+                            return;
+                        }
+                    }
+                    rects.push_back({x0, x1, row, static_cast<uint8_t>(row + 1)});
+                }
+            };
+            
+            const GlyphRects& glyphRects() {
+                static const GlyphRects rects;
+                return rects;
+            }
+            
+            // Glyph for the character at p, stepping past it; -1 for spaces
+            // and characters without a glyph. advance is in cells.
+            int nextGlyph(const char*& p, int& advance) {
+                unsigned char c = static_cast<unsigned char>(*p++);
+                int glyph = kGlyphMap.index[c];
+                if (glyph >= 0) {
+                    advance = kCellCount;
+                    return glyph;
+                }
+                
+                advance = kSpaceCells;
+                if (c == 0xC3 && *p != '\0') {
+                    // UTF-8 × and ÷ share the * and / glyphs
+                    unsigned char second = static_cast<unsigned char>(*p++);
+                    if (second == 0x97 || second == 0xB7) {
+                        advance = kCellCount;
+                        return kGlyphMap.index[static_cast<unsigned char>(second == 0x97 ? '*' : '/')];
+                    }
+                }
+                return -1;
+            }
+            
+            // Paint one glyph; its rects are clipped only when the glyph
+            // straddles the clip edge
+            void blitGlyph(uint32_t* buffer, int stride, const Rect& clip, const GlyphRects& glyphs,
+                           int glyph, int x, int y, int scale, uint32_t color) {
+                Rect box(x, y, kCellCount * scale, kCellCount * scale);
+                if (!box.intersects(clip)) return;
+                bool clipped = !clip.contains(box);
+                
+                for (int i = glyphs.first[glyph]; i < glyphs.first[glyph + 1]; i++) {
+                    const CellRect& cells = glyphs.rects[i];
+                    Rect rect(x + cells.x0 * scale, y + cells.y0 * scale,
+                              (cells.x1 - cells.x0) * scale, (cells.y1 - cells.y0) * scale);
+                    if (clipped) {
+                        rect = rect.intersected(clip);
+                        if (rect.isEmpty()) continue;
+                    }
+                    Span::paintRect(buffer, stride, rect, color);
                 }
             }
         }
         
+        void drawChar(char c, int x, int y, int scale, uint32_t color) {
+            if (!globalCanvas || scale <= 0) return;
+            
+            int glyph = kGlyphMap.index[static_cast<unsigned char>(c)];
+            if (glyph < 0) return; // Unsupported character
+            
+            const Rect& clip = globalCanvas->getClip();
+            if (!Rect(x, y, kCellCount * scale, kCellCount * scale).intersects(clip)) return;
+            globalCanvas->addDamage(x, y, kCellCount * scale, kCellCount * scale);
+            
+            blitGlyph(globalCanvas->getBuffer(), globalCanvas->getWidth(), clip, glyphRects(),
+                      glyph, x, y, scale, color);
+        }
+        
         void drawText(const char* text, int x, int y, int scale, uint32_t color) {
+            if (!globalCanvas || scale <= 0) return;
+            
+            // Measure first so the whole string is one damage rect and
+            // off-screen strings cost nothing more
+            int cells = 0;
+            int advance;
+            for (const char* p = text; *p != '\0';) {
+                nextGlyph(p, advance);
+                cells += advance;
+            }
+            
+            const Rect& clip = globalCanvas->getClip();
+            Rect area = Rect(x, y, cells * scale, kCellCount * scale).intersected(clip);
+            if (area.isEmpty()) return;
+            globalCanvas->addDamage(area.x, area.y, area.width, area.height);
+            
+            uint32_t* buffer = globalCanvas->getBuffer();
+            int stride = globalCanvas->getWidth();
+            const GlyphRects& glyphs = glyphRects();
+            
             int cursor_x = x;
-            for (const char* p = text; *p != '\0'; p++) {
-                if (*p == ' ') {
-                    cursor_x += 4 * scale;
-                    continue;
-                } else if ((*p >= 'A' && *p <= 'Z') || (*p >= 'a' && *p <= 'z') || (*p >= '0' && *p <= '9')) {
-                    drawChar(*p, cursor_x, y, scale, color);
-                    cursor_x += 8 * scale;
-                } else if (*p == '+' || *p == '-' || *p == '*' || *p == '/' || *p == '=' || 
-                          *p == '(' || *p == ')' || *p == '.' || *p == '!') {
-                    drawChar(*p, cursor_x, y, scale, color);
-                    cursor_x += 8 * scale;
-                } else if ((unsigned char)*p == 0xC3 && p[1] != '\0') {
-                    // Handle UTF-8 encoded symbols
-                    unsigned char second = (unsigned char)p[1];
-                    if (second == 0x97) { // ×
-                        drawChar('*', cursor_x, y, scale, color); // Use * mapping
-                        cursor_x += 8 * scale;
-                        p++; // Skip the second byte
-                    } else if (second == 0xB7) { // ÷  
-                        drawChar('/', cursor_x, y, scale, color); // Use / mapping
-                        cursor_x += 8 * scale;
-                        p++; // Skip the second byte
-                    } else {
-                        cursor_x += 4 * scale; // Unknown UTF-8 sequence
-                        p++; // Skip the second byte
-                    }
-                } else {
-                    // For other unsupported characters, just add some space
-                    cursor_x += 4 * scale;
+            for (const char* p = text; *p != '\0';) {
+                int glyph = nextGlyph(p, advance);
+                if (glyph >= 0) {
+                    blitGlyph(buffer, stride, clip, glyphs, glyph, cursor_x, y, scale, color);
                 }
+                cursor_x += advance * scale;
+            }
+        }
+        
+        int charWidth(uint32_t codepoint, int scale) {
+            // Mirrors nextGlyph(), which walks the UTF-8 bytes
+            int cells;
+            if (codepoint < 0x80) {
+                cells = kGlyphMap.index[codepoint] >= 0 ? kCellCount : kSpaceCells;
+            } else if (codepoint < 0x800) {
+                bool shared = codepoint == 0xD7 || codepoint == 0xF7;  // × and ÷
+                cells = shared ? kCellCount : codepoint >= 0xC0 && codepoint < 0x100 ? kSpaceCells : 2 * kSpaceCells;
+            } else {
+                cells = (codepoint < 0x10000 ? 3 : 4) * kSpaceCells;
             }
+            return cells * scale;
         }
     }
-}
\ No newline at end of file
+}
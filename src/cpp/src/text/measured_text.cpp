@@ -0,0 +1,120 @@
+#include "../../include/fern/text/measured_text.hpp"
+#include "../../include/fern/text/utf8.hpp"
+#include <algorithm>
+
+namespace Fern {
+
+void MeasuredText::setMetrics(AdvanceFunction advance, KerningFunction kerning) {
+    advance_ = std::move(advance);
+    kerning_ = std::move(kerning);
+}
+
+void MeasuredText::assign(const std::string& text) {
+    buffer_.clear();
+    gapStart_ = gapEnd_ = 0;
+    insert(0, text);
+}
+
+size_t MeasuredText::insert(size_t index, const std::string& text) {
+    moveGap(std::min(index, size()));
+    reserveGap(text.size()); // At least one byte per character
+
+    size_t added = 0;
+    for (size_t i = 0; i < text.size(); added++) {
+        size_t start = i;
+        uint32_t codepoint = Utf8::decode(text, i);
+
+        Entry entry;
+        entry.codepoint = codepoint;
+        entry.kerning = gapStart_ && kerning_ ? kerning_(buffer_[gapStart_ - 1].codepoint, codepoint) : 0;
+        entry.units = leftUnits() + (advance_ ? advance_(codepoint) : 0) + entry.kerning;
+        entry.bytes = leftBytes() + static_cast<uint32_t>(i - start);
+        buffer_[gapStart_++] = entry;
+    }
+
+    remeasureAfterGap();
+    return added;
+}
+
+void MeasuredText::erase(size_t index, size_t count) {
+    size_t length = size();
+    if (index >= length) return;
+    moveGap(index);
+    gapEnd_ += std::min(count, length - index);
+    remeasureAfterGap();
+}
+
+size_t MeasuredText::byteOffset(size_t index) const {
+    if (index <= gapStart_) {
+        return index ? buffer_[index - 1].bytes : 0;
+    }
+    size_t physical = index + (gapEnd_ - gapStart_);
+    uint32_t after = physical < buffer_.size() ? buffer_[physical].bytes : 0;
+    return leftBytes() + rightBytes() - after;
+}
+
+int32_t MeasuredText::offset(size_t index) const {
+    if (index <= gapStart_) {
+        return index ? buffer_[index - 1].units : 0;
+    }
+    size_t physical = index + (gapEnd_ - gapStart_);
+    int32_t after = physical < buffer_.size() ? buffer_[physical].units : 0;
+    return leftUnits() + rightUnits() - after;
+}
+
+int32_t MeasuredText::span(size_t first, size_t last) const {
+    if (last <= first) return 0;
+    return offset(last) - offset(first) - at(first).kerning;
+}
+
+size_t MeasuredText::indexAt(int32_t units) const {
+    size_t past = partitionPoint(0, size(), [&](size_t i) { return offset(i) > units; });
+    return past ? past - 1 : 0;
+}
+
+void MeasuredText::moveGap(size_t index) {
+    // Each character that crosses the gap swaps one running total for the
+    // other: its own width and bytes are recovered from its neighbour
+    while (gapStart_ > index) {
+        const Entry& moving = buffer_[gapStart_ - 1];
+        const Entry* before = gapStart_ > 1 ? &buffer_[gapStart_ - 2] : nullptr;
+        Entry entry = moving;
+        entry.units = moving.units - (before ? before->units : 0) + rightUnits();
+        entry.bytes = moving.bytes - (before ? before->bytes : 0) + rightBytes();
+        gapStart_--;
+        buffer_[--gapEnd_] = entry;
+    }
+    while (gapStart_ < index) {
+        const Entry& moving = buffer_[gapEnd_];
+        const Entry* after = gapEnd_ + 1 < buffer_.size() ? &buffer_[gapEnd_ + 1] : nullptr;
+        Entry entry = moving;
+        entry.units = moving.units - (after ? after->units : 0) + leftUnits();
+        entry.bytes = moving.bytes - (after ? after->bytes : 0) + leftBytes();
+        gapEnd_++;
+        buffer_[gapStart_++] = entry;
+    }
+}
+
+void MeasuredText::reserveGap(size_t count) {
+    if (gapEnd_ - gapStart_ >= count) return;
+
+    // Right-hand totals run to the end, so they move without changing
+    size_t tail = buffer_.size() - gapEnd_;
+    std::vector<Entry> grown(std::max(buffer_.size() * 2, size() + count + 16));
+    std::copy(buffer_.begin(), buffer_.begin() + gapStart_, grown.begin());
+    std::copy(buffer_.begin() + gapEnd_, buffer_.end(), grown.end() - tail);
+    gapEnd_ = grown.size() - tail;
+    buffer_.swap(grown);
+}
+
+void MeasuredText::remeasureAfterGap() {
+    // The character after an edit has a new left neighbour, so only its
+    // kerning changes; totals further right do not include it
+    if (gapEnd_ >= buffer_.size()) return;
+    Entry& next = buffer_[gapEnd_];
+    int32_t kerning = gapStart_ && kerning_ ? kerning_(buffer_[gapStart_ - 1].codepoint, next.codepoint) : 0;
+    next.units += kerning - next.kerning;
+    next.kerning = kerning;
+}
+
+}
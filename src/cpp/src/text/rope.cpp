@@ -0,0 +1,283 @@
+#include "../../include/fern/text/rope.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace Fern {
+
+struct Rope::Node {
+    std::string text;
+    size_t newlines = 0;     // In text
+    size_t bytes = 0;        // Subtree totals, this node included
+    size_t lines = 0;
+    uint32_t priority = 0;
+    NodePtr left;
+    NodePtr right;
+
+    static size_t bytesOf(const NodePtr& node) { return node ? node->bytes : 0; }
+    static size_t linesOf(const NodePtr& node) { return node ? node->lines : 0; }
+
+    void countNewlines() {
+        newlines = static_cast<size_t>(std::count(text.begin(), text.end(), '\n'));
+    }
+
+    void update() {
+        bytes = text.size();
+        lines = newlines;
+        if (left) {
+            bytes += left->bytes;
+            lines += left->lines;
+        }
+        if (right) {
+            bytes += right->bytes;
+            lines += right->lines;
+        }
+    }
+};
+
+Rope::Rope() = default;
+Rope::~Rope() = default;
+Rope::Rope(Rope&&) noexcept = default;
+Rope& Rope::operator=(Rope&&) noexcept = default;
+
+Rope::NodePtr Rope::makeNode(std::string text) {
+    // xorshift32; priorities only need to be well spread
+    seed_ ^= seed_ << 13;
+    seed_ ^= seed_ >> 17;
+    seed_ ^= seed_ << 5;
+
+    NodePtr node(new Node());
+    node->text = std::move(text);
+    node->priority = seed_;
+    node->countNewlines();
+    node->update();
+    return node;
+}
+
+Rope::NodePtr Rope::build(const std::string& text, size_t offset, size_t count) {
+    // Chunks are filled to half, leaving room to type into them in place
+    NodePtr result;
+    for (size_t end = offset + count; offset < end;) {
+        size_t length = std::min(kMaxChunk / 2, end - offset);
+        result = merge(std::move(result), makeNode(text.substr(offset, length)));
+        offset += length;
+    }
+    return result;
+}
+
+Rope::NodePtr Rope::merge(NodePtr left, NodePtr right) {
+    if (!left) return right;
+    if (!right) return left;
+    if (left->priority > right->priority) {
+        left->right = merge(std::move(left->right), std::move(right));
+        left->update();
+        return left;
+    }
+    right->left = merge(std::move(left), std::move(right->left));
+    right->update();
+    return right;
+}
+
+void Rope::split(NodePtr node, size_t offset, NodePtr& left, NodePtr& right) {
+    if (!node) {
+        left.reset();
+        right.reset();
+        return;
+    }
+
+    size_t leftBytes = Node::bytesOf(node->left);
+    size_t end = leftBytes + node->text.size();
+    if (offset <= leftBytes) {
+        split(std::move(node->left), offset, left, node->left);
+        node->update();
+        right = std::move(node);
+    } else if (offset >= end) {
+        split(std::move(node->right), offset - end, node->right, right);
+        node->update();
+        left = std::move(node);
+    } else {
+        // The cut falls inside this chunk. The tail becomes a node of the
+        // same priority, which keeps the heap order without rotations.
+        NodePtr tail(new Node());
+        tail->text = node->text.substr(offset - leftBytes);
+        tail->priority = node->priority;
+        tail->right = std::move(node->right);
+        tail->countNewlines();
+        tail->update();
+
+        node->text.resize(offset - leftBytes);
+        node->countNewlines();
+        node->update();
+        left = std::move(node);
+        right = std::move(tail);
+    }
+}
+
+bool Rope::insertInPlace(Node* node, size_t offset, const std::string& text) {
+    if (!node) return false;
+
+    size_t leftBytes = Node::bytesOf(node->left);
+    bool inserted;
+    if (node->left && offset <= leftBytes) {
+        inserted = insertInPlace(node->left.get(), offset, text);
+    } else if (offset - leftBytes <= node->text.size()) {
+        inserted = node->text.size() + text.size() <= kMaxChunk;
+        if (inserted) {
+            node->text.insert(offset - leftBytes, text);
+            node->newlines += static_cast<size_t>(std::count(text.begin(), text.end(), '\n'));
+        }
+    } else {
+        inserted = insertInPlace(node->right.get(), offset - leftBytes - node->text.size(), text);
+    }
+
+    if (inserted) node->update();
+    return inserted;
+}
+
+bool Rope::eraseInPlace(Node* node, size_t offset, size_t count) {
+    if (!node) return false;
+
+    size_t leftBytes = Node::bytesOf(node->left);
+    bool erased;
+    if (offset < leftBytes) {
+        erased = offset + count <= leftBytes && eraseInPlace(node->left.get(), offset, count);
+    } else if (offset - leftBytes < node->text.size()) {
+        // Whole chunks are left to split() and merge(), which drop them
+        size_t local = offset - leftBytes;
+        erased = local + count <= node->text.size() && count < node->text.size();
+        if (erased) {
+            node->newlines -= static_cast<size_t>(std::count(node->text.begin() + local,
+                                                             node->text.begin() + local + count, '\n'));
+            node->text.erase(local, count);
+        }
+    } else {
+        erased = eraseInPlace(node->right.get(), offset - leftBytes - node->text.size(), count);
+    }
+
+    if (erased) node->update();
+    return erased;
+}
+
+void Rope::assign(const std::string& text) {
+    root_ = build(text, 0, text.size());
+}
+
+void Rope::insert(size_t offset, const std::string& text) {
+    if (text.empty()) return;
+    offset = std::min(offset, size());
+    if (insertInPlace(root_.get(), offset, text)) return;
+
+    NodePtr left, right;
+    split(std::move(root_), offset, left, right);
+    root_ = merge(merge(std::move(left), build(text, 0, text.size())), std::move(right));
+}
+
+void Rope::erase(size_t offset, size_t count) {
+    size_t length = size();
+    if (offset >= length || count == 0) return;
+    count = std::min(count, length - offset);
+    if (eraseInPlace(root_.get(), offset, count)) return;
+
+    NodePtr left, middle, right;
+    split(std::move(root_), offset, left, right);
+    split(std::move(right), count, middle, right);
+    root_ = merge(std::move(left), std::move(right));
+}
+
+size_t Rope::size() const {
+    return Node::bytesOf(root_);
+}
+
+size_t Rope::lineCount() const {
+    return Node::linesOf(root_) + 1;
+}
+
+size_t Rope::lineStart(size_t line) const {
+    if (line == 0) return 0;
+    if (line > Node::linesOf(root_)) return size();
+
+    // Find the line-th newline; the line starts just after it
+    size_t base = 0;
+    for (const Node* node = root_.get(); node;) {
+        size_t leftLines = Node::linesOf(node->left);
+        if (line <= leftLines) {
+            node = node->left.get();
+            continue;
+        }
+        line -= leftLines;
+        base += Node::bytesOf(node->left);
+
+        if (line <= node->newlines) {
+            const char* text = node->text.data();
+            const char* p = text;
+            while (true) {
+                p = static_cast<const char*>(std::memchr(p, '\n', node->text.size() - (p - text))) + 1;
+                if (--line == 0) return base + (p - text);
+            }
+        }
+        line -= node->newlines;
+        base += node->text.size();
+        node = node->right.get();
+    }
+    return size();
+}
+
+size_t Rope::lineEnd(size_t line) const {
+    return line + 1 < lineCount() ? lineStart(line + 1) - 1 : size();
+}
+
+size_t Rope::lineOf(size_t offset) const {
+    size_t line = 0;
+    for (const Node* node = root_.get(); node;) {
+        size_t leftBytes = Node::bytesOf(node->left);
+        if (offset <= leftBytes) {
+            node = node->left.get();
+            continue;
+        }
+        line += Node::linesOf(node->left);
+        offset -= leftBytes;
+
+        if (offset <= node->text.size()) {
+            return line + static_cast<size_t>(std::count(node->text.begin(), node->text.begin() + offset, '\n'));
+        }
+        line += node->newlines;
+        offset -= node->text.size();
+        node = node->right.get();
+    }
+    return line;
+}
+
+void Rope::append(const Node* node, size_t offset, size_t count, std::string& output) {
+    if (!node || count == 0) return;
+
+    size_t leftBytes = Node::bytesOf(node->left);
+    if (offset < leftBytes) {
+        append(node->left.get(), offset, count, output);
+    }
+    size_t end = offset + count;
+    size_t textEnd = leftBytes + node->text.size();
+    if (offset < textEnd && end > leftBytes) {
+        size_t from = std::max(offset, leftBytes);
+        output.append(node->text, from - leftBytes, std::min(end, textEnd) - from);
+    }
+    if (end > textEnd) {
+        size_t from = std::max(offset, textEnd);
+        append(node->right.get(), from - textEnd, end - from, output);
+    }
+}
+
+std::string Rope::substr(size_t offset, size_t count) const {
+    std::string output;
+    size_t length = size();
+    if (offset >= length) return output;
+    count = std::min(count, length - offset);
+    output.reserve(count);
+    append(root_.get(), offset, count, output);
+    return output;
+}
+
+std::string Rope::line(size_t line) const {
+    size_t start = lineStart(line);
+    return substr(start, lineEnd(line) - start);
+}
+
+}
@@ -56,14 +56,25 @@ namespace Fern {
                                    std::shared_ptr<Widget> child)
         : ContainerWidget(color, x, y, width, height) {
         child_ = child;
+        if (child_) adopt(*child_, this);
+    }
+    
+    ContainerWidget::~ContainerWidget() {
+        if (child_ && child_->getParent() == this) adopt(*child_, nullptr);
     }
     
     void ContainerWidget::render() {
+        bool sized = width_ > 0 && height_ > 0;
+        if (sized && globalCanvas->isClippedOut(x_, y_, width_, height_)) return;
+        
         Draw::rect(x_, y_, width_, height_, color_);
         
         if (child_) {
+            // Keep the child inside the container's background
+            if (sized) globalCanvas->pushClip(x_, y_, width_, height_);
             child_->setPosition(x_, y_);
             child_->render();
+            if (sized) globalCanvas->popClip();
         }
     }
     
@@ -76,23 +87,37 @@ namespace Fern {
     }
     
     void ContainerWidget::setChild(std::shared_ptr<Widget> child) {
+        if (child_ && child_->getParent() == this) adopt(*child_, nullptr);
         child_ = child;
         
-            if (child_) {
-                child_->setPosition(x_, y_);
-                
-                if (child_->getWidth() <= 0) {
-                    child_->resize(width_, child_->getHeight());
-                }
-                if (child_->getHeight() <= 0) {
-                    child_->resize(child_->getWidth(), height_);
-                }
-                
-                auto layoutWidget = std::dynamic_pointer_cast<LayoutWidget>(child_);
-                if (layoutWidget) {
-                    layoutWidget->updateLayout();
-                }
-            }
+        if (child_) {
+            adopt(*child_, this);
+            invalidateLayout();
+        }
+    }
+    
+    Size ContainerWidget::onMeasure(const Constraints& constraints) {
+        Size size(width_, height_);
+        if (child_ && (size.width <= 0 || size.height <= 0)) {
+            Size content = child_->measure(constraints);
+            if (size.width <= 0) size.width = content.width;
+            if (size.height <= 0) size.height = content.height;
+        }
+        return constraints.constrain(size);
+    }
+    
+    void ContainerWidget::onArrange(const Rect& bounds) {
+        x_ = bounds.x;
+        y_ = bounds.y;
+        width_ = bounds.width;
+        height_ = bounds.height;
+        if (!child_) return;
+        
+        // A child that doesn't know its size fills the container
+        Size size = child_->measure(Constraints(width_, height_));
+        if (size.width <= 0) size.width = width_;
+        if (size.height <= 0) size.height = height_;
+        child_->arrange(Rect(x_, y_, size.width, size.height));
     }
     
     std::shared_ptr<ContainerWidget> Container(
@@ -8,44 +8,42 @@ CenterWidget::CenterWidget(int x, int y, int width, int height)
     : LayoutWidget(x, y, width, height) {}
 
 void CenterWidget::add(std::shared_ptr<Widget> child) {
-    children_.clear();
-    children_.push_back(child);
-    arrangeChildren();
+    clearChildren();
+    addChild(child);
+    invalidateLayout();
+}
+
+Size CenterWidget::onMeasure(const Constraints& constraints) {
+    // The child is only asked along axes with neither a bound nor a fixed size
+    bool wrapWidth = !constraints.hasBoundedWidth() && explicitWidth_ <= 0;
+    bool wrapHeight = !constraints.hasBoundedHeight() && explicitHeight_ <= 0;
+    Size size;
+    if ((wrapWidth || wrapHeight) && !children_.empty()) {
+        size = children_[0]->measure(constraints);
+    }
+    if (constraints.hasBoundedWidth()) size.width = constraints.maxWidth;
+    if (constraints.hasBoundedHeight()) size.height = constraints.maxHeight;
+    return constraints.constrain(withExplicitSize(size));
 }
 
 void CenterWidget::arrangeChildren() {
     if (children_.empty()) return;
     
     auto& child = children_[0];
+    Size size = child->measure(Constraints(width_, height_));
     
-    if (child->getWidth() <= 0 || child->getHeight() <= 0) {
-        if (width_ > 0 && child->getWidth() <= 0) {
-            child->resize(width_, child->getHeight());
-        }
-        if (height_ > 0 && child->getHeight() <= 0) {
-            child->resize(child->getWidth(), height_);
-        }
-    }
-    
-    int childX = x_;
-    int childY = y_;
-    
-    if (width_ > 0 && child->getWidth() > 0) {
-        childX = x_ + (width_ - child->getWidth()) / 2;
-    }
-    
-    if (height_ > 0 && child->getHeight() > 0) {
-        childY = y_ + (height_ - child->getHeight()) / 2;
-    }
+    // A child that doesn't know its size takes all of ours
+    if (size.width <= 0) size.width = width_;
+    if (size.height <= 0) size.height = height_;
     
-    child->setPosition(childX, childY);
+    int childX = x_ + (width_ - size.width) / 2;
+    int childY = y_ + (height_ - size.height) / 2;
+    child->arrange(Rect(childX, childY, size.width, size.height));
 }
 
 void CenterWidget::onWindowResize(int newWidth, int newHeight) {
-    // Update this widget's dimensions to match the new window size
+    // Fill the new window; resize() lays the child out again
     resize(newWidth, newHeight);
-    // Re-arrange children to center them in the new dimensions
-    arrangeChildren();
 }
 
 std::shared_ptr<CenterWidget> Center(std::shared_ptr<Widget> child, bool addToManager) {
@@ -1,5 +1,6 @@
 #include "fern/ui/layout/layout.hpp"
 #include "fern/core/widget_manager.hpp"
+#include <algorithm>
 #include <cstdio>
 
 #ifdef __EMSCRIPTEN__
@@ -15,55 +16,107 @@ ColumnWidget::ColumnWidget(int x, int y, int width, int height,
       mainAxisAlignment_(mainAlignment),
       crossAxisAlignment_(crossAlignment) {}
 
+namespace {
+    // Gap between children with MainAxisAlignment::Start
+    constexpr int kMinSpacing = 5;
+}
+
 void ColumnWidget::add(std::shared_ptr<Widget> child) {
-    children_.push_back(child);
-    arrangeChildren();
+    addChild(child);
+    invalidateLayout();
 }
 
 void ColumnWidget::addAll(const std::vector<std::shared_ptr<Widget>>& children) {
-    children_.insert(children_.end(), children.begin(), children.end());
-    arrangeChildren();
+    for (auto& child : children) {
+        addChild(child);
+    }
+    invalidateLayout();
+}
+
+void ColumnWidget::clear() {
+    clearChildren();
+    invalidateLayout();
+}
+
+void ColumnWidget::setMainAxisAlignment(MainAxisAlignment alignment) {
+    mainAxisAlignment_ = alignment;
+    invalidateLayout();
+}
+
+void ColumnWidget::setCrossAxisAlignment(CrossAxisAlignment alignment) {
+    crossAxisAlignment_ = alignment;
+    invalidateLayout();
+}
+
+Constraints ColumnWidget::childConstraints(int width) const {
+    // Children may be as tall as they like; the column decides how much
+    // height each one gets when it arranges them
+    int minWidth = crossAxisAlignment_ == CrossAxisAlignment::Stretch && width < Constraints::kUnbounded ? width : 0;
+    return Constraints(minWidth, 0, width, Constraints::kUnbounded);
+}
+
+Size ColumnWidget::onMeasure(const Constraints& constraints) {
+    int width = explicitWidth_ > 0 ? std::min(explicitWidth_, constraints.maxWidth) : constraints.maxWidth;
+    Constraints childLimits = childConstraints(width);
+    
+    Size content;
+    int gaps = -1;
+    for (auto& child : children_) {
+        Size size = child->measure(childLimits);
+        content.width = std::max(content.width, size.width);
+        content.height += size.height;
+        if (!child->hasCapability(WidgetCapability::Spacing)) gaps++;
+    }
+    if (mainAxisAlignment_ == MainAxisAlignment::Start && gaps > 0) {
+        content.height += gaps * kMinSpacing;
+    }
+    
+    if (crossAxisAlignment_ == CrossAxisAlignment::Stretch && constraints.hasBoundedWidth()) {
+        content.width = width;
+    }
+    if (constraints.hasBoundedHeight()) {
+        content.height = constraints.maxHeight;
+    }
+    return constraints.constrain(withExplicitSize(content));
 }
 
 void ColumnWidget::arrangeChildren() {
     if (children_.empty()) return;
     
+    // Measuring again is free: children cache their size per constraint
+    Constraints childLimits = childConstraints(width_);
     int totalFixedHeight = 0;
     int totalFlex = 0;
     int spacingWidgetsHeight = 0;
+    int gaps = -1;
     
     for (auto& child : children_) {
-        auto expanded = std::dynamic_pointer_cast<ExpandedWidget>(child);
-        auto spacingWidget = std::dynamic_pointer_cast<SpacingWidget>(child);
+        auto expanded = widgetCast<ExpandedWidget>(child.get());
+        auto spacingWidget = widgetCast<SpacingWidget>(child.get());
 
         if (spacingWidget) {
             // In a column, spacing widget height creates vertical space
-            spacingWidgetsHeight += child->getHeight();
+            spacingWidgetsHeight += child->measure(childLimits).height;
             continue;
         }
 
+        gaps++;
         if (expanded) {
             totalFlex += expanded->getFlex();
         } else {
-            // Count actual or default height for fixed widgets
-            int widgetHeight = child->getHeight() > 0 ? child->getHeight() : 40; // Default 40px
-            totalFixedHeight += widgetHeight;
+            totalFixedHeight += child->measure(childLimits).height;
         }
     }
     
-    int availableHeight = height_ - totalFixedHeight - spacingWidgetsHeight;
-    if (availableHeight < 0) availableHeight = 0;
-    
     int startY = y_;
     int spacingBetween = 0; 
     int remainingSpace = height_ - totalFixedHeight - spacingWidgetsHeight;
     
-    // Add minimum spacing between widgets if no explicit spacing is provided
-    int minSpacing = 5; // 5px minimum spacing between widgets
-    
     switch (mainAxisAlignment_) {
         case MainAxisAlignment::Start:
-            spacingBetween = minSpacing;
+            // Add minimum spacing between widgets if no explicit spacing is provided
+            spacingBetween = kMinSpacing;
+            remainingSpace -= std::max(0, gaps) * kMinSpacing;
             break;
             
         case MainAxisAlignment::Center:
@@ -76,78 +129,65 @@ void ColumnWidget::arrangeChildren() {
             
         case MainAxisAlignment::SpaceBetween:
             if (children_.size() > 1) {
-                spacingBetween = remainingSpace / (children_.size() - 1);
+                spacingBetween = remainingSpace / static_cast<int>(children_.size() - 1);
             }
             break;
             
         case MainAxisAlignment::SpaceAround:
-            if (children_.size() > 0) {
-                spacingBetween = remainingSpace / children_.size();
-                startY = y_ + spacingBetween / 2;
-            }
+            spacingBetween = remainingSpace / static_cast<int>(children_.size());
+            startY = y_ + spacingBetween / 2;
             break;
             
         case MainAxisAlignment::SpaceEvenly:
-            if (children_.size() + 1 > 0) {
-                spacingBetween = remainingSpace / (children_.size() + 1);
-                startY = y_ + spacingBetween;
-            }
+            spacingBetween = remainingSpace / static_cast<int>(children_.size() + 1);
+            startY = y_ + spacingBetween;
             break;
     }
     
+    int availableHeight = std::max(0, remainingSpace);
     int currentY = startY;
     
     for (auto& child : children_) {
-        auto expanded = std::dynamic_pointer_cast<ExpandedWidget>(child);
-        auto spacingWidget = std::dynamic_pointer_cast<SpacingWidget>(child);
+        auto expanded = widgetCast<ExpandedWidget>(child.get());
+        auto spacingWidget = widgetCast<SpacingWidget>(child.get());
+        Size size = child->measure(childLimits);
 
         if (spacingWidget) {
             // In a column, spacing widget height creates vertical space
-            currentY += child->getHeight();
+            child->arrange(Rect(x_, currentY, size.width, size.height));
+            currentY += size.height;
             continue;
         }
         
-        int childHeight = 0;
+        int childHeight = size.height;
+        int childWidth = size.width;
         if (expanded) {
             childHeight = (totalFlex > 0) ? (availableHeight * expanded->getFlex()) / totalFlex : 0;
-        } else {
-            // If widget doesn't have explicit height, give it a reasonable default
-            childHeight = child->getHeight() > 0 ? child->getHeight() : 40; // Default 40px height
+            childWidth = width_;
+        } else if (crossAxisAlignment_ == CrossAxisAlignment::Stretch || childWidth <= 0) {
+            // Children that don't know their width take the column's
+            childWidth = width_;
         }
         
         int childX = x_;
         switch (crossAxisAlignment_) {
             case CrossAxisAlignment::Start:
+            case CrossAxisAlignment::Stretch:
                 childX = x_;
                 break;
                 
             case CrossAxisAlignment::Center:
-                if (child->getWidth() > 0 && child->getWidth() < width_) {
-                    childX = x_ + (width_ - child->getWidth()) / 2;
+                if (childWidth < width_) {
+                    childX = x_ + (width_ - childWidth) / 2;
                 }
                 break;
                 
             case CrossAxisAlignment::End:
-                if (child->getWidth() > 0) {
-                    childX = x_ + width_ - child->getWidth();
-                }
+                childX = x_ + width_ - childWidth;
                 break;
-                
-            case CrossAxisAlignment::Stretch:
-                childX = x_;
-                break;
-        }
-        
-        child->setPosition(childX, currentY);
-        
-        if (crossAxisAlignment_ == CrossAxisAlignment::Stretch) {
-            child->resize(width_, childHeight);
-        } else if (child->getWidth() <= 0) {
-            child->resize(width_, childHeight);
-        } else {
-            child->resize(child->getWidth(), childHeight);
         }
         
+        child->arrange(Rect(childX, currentY, childWidth, childHeight));
         currentY += childHeight + spacingBetween; 
     }
 }
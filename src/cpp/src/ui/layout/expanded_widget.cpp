@@ -5,8 +5,9 @@ namespace Fern {
     
     ExpandedWidget::ExpandedWidget(std::shared_ptr<Widget> child, int flex)
         : LayoutWidget(0, 0, 0, 0), flex_(flex) {
+        addCapabilities(WidgetCapability::Expanded);
         if (child) {
-            children_.push_back(child);
+            addChild(child);
         }
     }
     
@@ -16,10 +17,13 @@ namespace Fern {
         }
     }
     
+    Size ExpandedWidget::onMeasure(const Constraints& constraints) {
+        return children_.empty() ? constraints.constrain(Size()) : children_[0]->measure(constraints);
+    }
+    
     void ExpandedWidget::arrangeChildren() {
         if (!children_.empty()) {
-            children_[0]->resize(width_, height_);
-            children_[0]->setPosition(x_, y_);
+            children_[0]->arrange(Rect(x_, y_, width_, height_));
         }
     }
     
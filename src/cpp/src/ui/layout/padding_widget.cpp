@@ -1,6 +1,7 @@
 #include "fern/ui/layout/layout.hpp"
 #include "fern/core/widget_manager.hpp"
 #include "../../../include/fern/fern.hpp"
+#include <algorithm>
 
 
 namespace Fern {
@@ -12,9 +13,24 @@ PaddingWidget::PaddingWidget(int x, int y, int width, int height,
       paddingRight_(right), paddingBottom_(bottom) {}
 
 void PaddingWidget::add(std::shared_ptr<Widget> child) {
-    children_.clear();
-    children_.push_back(child);
-    arrangeChildren();
+    clearChildren();
+    addChild(child);
+    invalidateLayout();
+}
+
+Size PaddingWidget::onMeasure(const Constraints& constraints) {
+    int horizontal = paddingLeft_ + paddingRight_;
+    int vertical = paddingTop_ + paddingBottom_;
+    Size size;
+    if (!children_.empty()) {
+        // An unbounded axis stays unbounded, or the child would fill it
+        Constraints inner(constraints.hasBoundedWidth() ? std::max(0, constraints.maxWidth - horizontal) : Constraints::kUnbounded,
+                          constraints.hasBoundedHeight() ? std::max(0, constraints.maxHeight - vertical) : Constraints::kUnbounded);
+        size = children_[0]->measure(inner);
+    }
+    size.width += horizontal;
+    size.height += vertical;
+    return constraints.constrain(withExplicitSize(size));
 }
 
 void PaddingWidget::arrangeChildren() {
@@ -27,8 +43,7 @@ void PaddingWidget::arrangeChildren() {
     int childWidth = width_ - paddingLeft_ - paddingRight_;
     int childHeight = height_ - paddingTop_ - paddingBottom_;
     
-    child->setPosition(childX, childY);
-    child->resize(childWidth, childHeight);
+    child->arrange(Rect(childX, childY, childWidth, childHeight));
 }
 
 
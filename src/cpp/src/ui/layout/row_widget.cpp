@@ -1,6 +1,7 @@
 #include "fern/ui/layout/layout.hpp"
 #include "fern/core/widget_manager.hpp"
 #include "../../../include/fern/fern.hpp"
+#include <algorithm>
 
 namespace Fern {
 
@@ -12,36 +13,72 @@ RowWidget::RowWidget(int x, int y, int width, int height,
       crossAxisAlignment_(crossAlignment) {}
 
 void RowWidget::add(std::shared_ptr<Widget> child) {
-    children_.push_back(child);
-    arrangeChildren();
+    addChild(child);
+    invalidateLayout();
 }
 
 void RowWidget::addAll(const std::vector<std::shared_ptr<Widget>>& children) {
-    children_.insert(children_.end(), children.begin(), children.end());
-    arrangeChildren();
+    for (auto& child : children) {
+        addChild(child);
+    }
+    invalidateLayout();
+}
+
+void RowWidget::clear() {
+    clearChildren();
+    invalidateLayout();
+}
+
+Constraints RowWidget::childConstraints(int height) const {
+    // Children may be as wide as they like; the row decides how much
+    // width each one gets when it arranges them
+    int minHeight = crossAxisAlignment_ == CrossAxisAlignment::Stretch && height < Constraints::kUnbounded ? height : 0;
+    return Constraints(0, minHeight, Constraints::kUnbounded, height);
+}
+
+Size RowWidget::onMeasure(const Constraints& constraints) {
+    int height = explicitHeight_ > 0 ? std::min(explicitHeight_, constraints.maxHeight) : constraints.maxHeight;
+    Constraints childLimits = childConstraints(height);
+    
+    Size content;
+    for (auto& child : children_) {
+        Size size = child->measure(childLimits);
+        content.width += size.width;
+        content.height = std::max(content.height, size.height);
+    }
+    
+    if (crossAxisAlignment_ == CrossAxisAlignment::Stretch && constraints.hasBoundedHeight()) {
+        content.height = height;
+    }
+    if (constraints.hasBoundedWidth()) {
+        content.width = constraints.maxWidth;
+    }
+    return constraints.constrain(withExplicitSize(content));
 }
 
 void RowWidget::arrangeChildren() {
     if (children_.empty()) return;
     
+    // Measuring again is free: children cache their size per constraint
+    Constraints childLimits = childConstraints(height_);
     int totalFixedWidth = 0;
     int totalFlex = 0;
     int spacingWidgetsWidth = 0;
 
     for (auto& child : children_) {
-        auto expanded = std::dynamic_pointer_cast<ExpandedWidget>(child);
-        auto spacingWidget = std::dynamic_pointer_cast<SpacingWidget>(child);
+        auto expanded = widgetCast<ExpandedWidget>(child.get());
+        auto spacingWidget = widgetCast<SpacingWidget>(child.get());
 
         if (spacingWidget) {
             // In a row, spacing widget width creates horizontal space
-            spacingWidgetsWidth += child->getWidth();
+            spacingWidgetsWidth += child->measure(childLimits).width;
             continue;
         }
 
         if (expanded) {
             totalFlex += expanded->getFlex();
-        } else if (child->getWidth() > 0) {
-            totalFixedWidth += child->getWidth();
+        } else {
+            totalFixedWidth += child->measure(childLimits).width;
         }
     }
     
@@ -63,83 +100,71 @@ void RowWidget::arrangeChildren() {
             break;
         case MainAxisAlignment::SpaceBetween:
             if (children_.size() > 1)
-                spacing = remainingSpace / (children_.size() - 1);
+                spacing = remainingSpace / static_cast<int>(children_.size() - 1);
             break;
         case MainAxisAlignment::SpaceAround:
-            if (children_.size() > 0) {
-                spacing = remainingSpace / children_.size();
-                startX = x_ + spacing / 2;
-            }
+            spacing = remainingSpace / static_cast<int>(children_.size());
+            startX = x_ + spacing / 2;
             break;
         case MainAxisAlignment::SpaceEvenly:
-            if (children_.size() + 1 > 0) {
-                spacing = remainingSpace / (children_.size() + 1);
-                startX = x_ + spacing;
-            }
+            spacing = remainingSpace / static_cast<int>(children_.size() + 1);
+            startX = x_ + spacing;
             break;
     }
     
     int currentX = startX;
     
     for (auto& child : children_) {
-        auto expanded = std::dynamic_pointer_cast<ExpandedWidget>(child);
-        auto spacingWidget = std::dynamic_pointer_cast<SpacingWidget>(child);
+        auto expanded = widgetCast<ExpandedWidget>(child.get());
+        auto spacingWidget = widgetCast<SpacingWidget>(child.get());
+        Size size = child->measure(childLimits);
 
         if (spacingWidget) {
             // In a row, spacing widget width creates horizontal space
-            currentX += child->getWidth();
+            child->arrange(Rect(currentX, y_, size.width, size.height));
+            currentX += size.width;
             continue;
         }
 
-        int childWidth = 0;
+        int childWidth = size.width;
+        int childHeight = size.height;
         if (expanded) {
             childWidth = (totalFlex > 0) ? (availableWidth * expanded->getFlex()) / totalFlex : 0;
-        } else {
-            childWidth = child->getWidth() > 0 ? child->getWidth() : 0;
+            childHeight = height_;
+        } else if (crossAxisAlignment_ == CrossAxisAlignment::Stretch || childHeight <= 0) {
+            // Children that don't know their height take the row's
+            childHeight = height_;
         }
 
         int childY = y_;
         switch (crossAxisAlignment_) {
             case CrossAxisAlignment::Start:
+            case CrossAxisAlignment::Stretch:
                 childY = y_;
                 break;
             case CrossAxisAlignment::Center:
-                if (child->getHeight() > 0 && child->getHeight() < height_) {
-                    childY = y_ + (height_ - child->getHeight()) / 2;
+                if (childHeight < height_) {
+                    childY = y_ + (height_ - childHeight) / 2;
                 }
                 break;
             case CrossAxisAlignment::End:
-                if (child->getHeight() > 0) {
-                    childY = y_ + height_ - child->getHeight();
-                }
-                break;
-            case CrossAxisAlignment::Stretch:
-                childY = y_;
+                childY = y_ + height_ - childHeight;
                 break;
         }
 
-        child->setPosition(currentX, childY);
-
-        if (crossAxisAlignment_ == CrossAxisAlignment::Stretch) {
-            child->resize(childWidth, height_);
-        } else if (child->getHeight() <= 0) {
-            child->resize(childWidth, height_);
-        } else {
-            child->resize(childWidth, child->getHeight());
-        }
-
+        child->arrange(Rect(currentX, childY, childWidth, childHeight));
         currentX += childWidth + spacing;
     }
 }
 
 void RowWidget::setMainAxisAlignment(MainAxisAlignment alignment) {
     mainAxisAlignment_ = alignment;
-    arrangeChildren(); // Trigger layout update
+    invalidateLayout();
 }
 
 void RowWidget::setCrossAxisAlignment(CrossAxisAlignment alignment) {
     crossAxisAlignment_ = alignment;
-    arrangeChildren(); // Trigger layout update
+    invalidateLayout();
 }
 
 std::shared_ptr<RowWidget> Row(
@@ -4,6 +4,7 @@
 namespace Fern {
 
 SpacingWidget::SpacingWidget(int width, int height) {
+    addCapabilities(WidgetCapability::Spacing);
     width_ = width;
     height_ = height;
 }
@@ -38,19 +38,12 @@ namespace Fern {
             uint32_t borderColor = config_.getStyle().getBorderColor();
             int borderRadius = config_.getStyle().getBorderRadius();
             
-            if (borderRadius > 0) {
-                // Use rounded rectangle border
-                Draw::roundedRectBorder(x_ - borderWidth, y_ - borderWidth, 
-                                      config_.getWidth() + 2 * borderWidth, 
-                                      config_.getHeight() + 2 * borderWidth, 
-                                      borderRadius + borderWidth, borderWidth, borderColor);
-            } else {
-                // Draw border as 4 lines (since we don't have rectOutline)
-                Draw::line(x_ - borderWidth, y_ - borderWidth, x_ + config_.getWidth() + borderWidth, y_ - borderWidth, borderWidth, borderColor); // Top
-                Draw::line(x_ - borderWidth, y_ + config_.getHeight() + borderWidth, x_ + config_.getWidth() + borderWidth, y_ + config_.getHeight() + borderWidth, borderWidth, borderColor); // Bottom
-                Draw::line(x_ - borderWidth, y_ - borderWidth, x_ - borderWidth, y_ + config_.getHeight() + borderWidth, borderWidth, borderColor); // Left
-                Draw::line(x_ + config_.getWidth() + borderWidth, y_ - borderWidth, x_ + config_.getWidth() + borderWidth, y_ + config_.getHeight() + borderWidth, borderWidth, borderColor); // Right
-            }
+            // Border sits outside the button, following its corners
+            int outerRadius = borderRadius > 0 ? borderRadius + borderWidth : 0;
+            Draw::roundedRectBorder(x_ - borderWidth, y_ - borderWidth, 
+                                  config_.getWidth() + 2 * borderWidth, 
+                                  config_.getHeight() + 2 * borderWidth, 
+                                  outerRadius, borderWidth, borderColor);
         }
     }
     
@@ -135,6 +128,7 @@ namespace Fern {
     
     void ButtonWidget::setLabel(const std::string& label) {
         config_.label(label);
+        invalidate();
     }
     
     void ButtonWidget::autoSizeToContent(int padding) {
@@ -42,6 +42,7 @@ namespace Fern {
     
     void CircleWidget::setRadius(int radius) {
         radius_ = radius;
+        invalidate();
     }
     
     void CircleWidget::setPosition(const Point& position){
@@ -52,6 +53,7 @@ namespace Fern {
     
     void CircleWidget::setColor(uint32_t color) {
         color_ = color;
+        invalidate();
     }
     
     std::shared_ptr<CircleWidget> Circle(int radius, Point position, uint32_t color, bool addToManager) {
@@ -22,15 +22,15 @@ namespace Fern {
         int centerX = x_ + config_.getRadius();
         int centerY = y_ + config_.getRadius();
         
-        // Draw background circle
-        Draw::circle(centerX, centerY, config_.getRadius(), style.getBackgroundColor());
+        // Draw background circle, leaving room for the border ring around it
+        int borderWidth = style.getBorderWidth();
+        int bgRadius = borderWidth > 0 ? config_.getRadius() - 1 : config_.getRadius();
+        Draw::circle(centerX, centerY, bgRadius, style.getBackgroundColor());
         
         // Draw border if enabled
-        if (style.getBorderWidth() > 0) {
-            for (int i = 0; i < style.getBorderWidth(); ++i) {
-                // Draw border as concentric circles (simplified)
-                Draw::circle(centerX, centerY, config_.getRadius() + i, style.getBorderColor());
-            }
+        if (borderWidth > 0) {
+            Draw::ring(centerX, centerY, bgRadius, bgRadius + borderWidth, 0.0f, 360.0f,
+                       style.getBorderColor());
         }
         
         // Draw progress arc
@@ -61,6 +61,7 @@ namespace Fern {
         clampValue();
         
         if (oldValue != currentValue_) {
+            invalidate();
             onValueChanged.emit(currentValue_);
             
             // Check if we reached 100%
@@ -91,20 +92,10 @@ namespace Fern {
     
     void CircularIndicatorWidget::renderArc(int centerX, int centerY, int radius, 
                                            float startAngle, float endAngle, uint32_t color) {
-        // Simplified arc rendering using lines
-        const float step = 2.0f; // Degree step for smoother arc
-        float currentAngle = startAngle;
-        
-        while (currentAngle <= endAngle) {
-            float radians = currentAngle * M_PI / 180.0f;
-            int x1 = centerX + static_cast<int>((radius - config_.getStyle().getThickness() / 2) * cos(radians));
-            int y1 = centerY + static_cast<int>((radius - config_.getStyle().getThickness() / 2) * sin(radians));
-            int x2 = centerX + static_cast<int>((radius + config_.getStyle().getThickness() / 2) * cos(radians));
-            int y2 = centerY + static_cast<int>((radius + config_.getStyle().getThickness() / 2) * sin(radians));
-            
-            Draw::line(x1, y1, x2, y2, 2, color);
-            currentAngle += step;
-        }
+        // Band of the style's thickness centered on radius
+        int thickness = config_.getStyle().getThickness();
+        int innerRadius = radius - thickness / 2 - 1;
+        Draw::ring(centerX, centerY, innerRadius, innerRadius + thickness, startAngle, endAngle, color);
     }
     
     void CircularIndicatorWidget::renderText() {
@@ -70,6 +70,7 @@ namespace Fern {
     void DropdownWidget::setSelectedIndex(int index) {
         if (index >= -1 && index < static_cast<int>(config_.getItems().size()) && selectedIndex_ != index) {
             selectedIndex_ = index;
+            invalidate();
             onSelectionChanged.emit(selectedIndex_);
             
             if (selectedIndex_ >= 0) {
@@ -99,6 +100,7 @@ namespace Fern {
         if (selectedIndex_ >= static_cast<int>(items.size())) {
             selectedIndex_ = -1;
         }
+        invalidate();
     }
     
     void DropdownWidget::open() {
@@ -124,16 +126,7 @@ namespace Fern {
         Draw::rect(x_, y_, config_.getWidth(), config_.getHeight(), bgColor);
         
         // Draw border
-        for (int i = 0; i < style.getBorderWidth(); ++i) {
-            // Top border
-            Draw::rect(x_ - i, y_ - i, config_.getWidth() + 2 * i, 1, style.getBorderColor());
-            // Bottom border
-            Draw::rect(x_ - i, y_ + config_.getHeight() + i - 1, config_.getWidth() + 2 * i, 1, style.getBorderColor());
-            // Left border
-            Draw::rect(x_ - i, y_ - i, 1, config_.getHeight() + 2 * i, style.getBorderColor());
-            // Right border
-            Draw::rect(x_ + config_.getWidth() + i - 1, y_ - i, 1, config_.getHeight() + 2 * i, style.getBorderColor());
-        }
+        renderBorder(y_, config_.getHeight());
         
         // Draw text
         std::string displayText;
@@ -145,7 +138,11 @@ namespace Fern {
         
         int textX = x_ + style.getPadding();
         int textY = y_ + (config_.getHeight() - style.getFontSize() * 8) / 2;
+        
+        // Long labels are cut off where the arrow starts
+        globalCanvas->pushClip(textX, y_, getTextAreaWidth(), config_.getHeight());
         renderText(displayText, textX, textY, style.getTextColor());
+        globalCanvas->popClip();
         
         // Draw dropdown arrow
         renderArrow();
@@ -165,18 +162,10 @@ namespace Fern {
         Draw::rect(x_, dropdownY, config_.getWidth(), dropdownHeight, style.getDropdownBackgroundColor());
         
         // Draw dropdown border
-        for (int i = 0; i < style.getBorderWidth(); ++i) {
-            // Top border
-            Draw::rect(x_ - i, dropdownY - i, config_.getWidth() + 2 * i, 1, style.getBorderColor());
-            // Bottom border
-            Draw::rect(x_ - i, dropdownY + dropdownHeight + i - 1, config_.getWidth() + 2 * i, 1, style.getBorderColor());
-            // Left border
-            Draw::rect(x_ - i, dropdownY - i, 1, dropdownHeight + 2 * i, style.getBorderColor());
-            // Right border
-            Draw::rect(x_ + config_.getWidth() + i - 1, dropdownY - i, 1, dropdownHeight + 2 * i, style.getBorderColor());
-        }
+        renderBorder(dropdownY, dropdownHeight);
         
-        // Draw items
+        // Draw items, keeping them inside the list
+        globalCanvas->pushClip(x_, dropdownY, config_.getWidth(), dropdownHeight);
         int visibleItems = std::min(static_cast<int>(items.size()), style.getMaxVisibleItems());
         for (int i = 0; i < visibleItems; ++i) {
             int itemY = dropdownY + i * itemHeight;
@@ -189,56 +178,52 @@ namespace Fern {
             // Draw item text
             int textX = x_ + style.getPadding();
             int textY = itemY + (itemHeight - style.getFontSize() * 8) / 2;
+            globalCanvas->pushClip(textX, itemY, getTextAreaWidth(), itemHeight);
             renderText(items[i].text, textX, textY, style.getTextColor());
+            globalCanvas->popClip();
         }
+        globalCanvas->popClip();
+    }
+    
+    void DropdownWidget::renderBorder(int top, int height) {
+        const auto& style = config_.getStyle();
+        int borderWidth = style.getBorderWidth();
+        if (borderWidth <= 0) return;
+        
+        // The innermost pixel of the border is the edge of the box itself;
+        // the rest grows outward
+        int grow = borderWidth - 1;
+        Draw::roundedRectBorder(x_ - grow, top - grow, config_.getWidth() + 2 * grow,
+                                height + 2 * grow, 0, borderWidth, style.getBorderColor());
     }
     
     void DropdownWidget::renderArrow() {
         const auto& style = config_.getStyle();
         
-        // Simple arrow using lines
+        // Chevron drawn as a single two-segment stroke
         int arrowX = x_ + config_.getWidth() - 20;
         int arrowY = y_ + config_.getHeight() / 2;
+        int tip = isOpen_ ? -2 : 2;  // Up arrow when open, down arrow when closed
         
-        if (isOpen_) {
-            // Up arrow
-            Draw::line(arrowX - 4, arrowY + 2, arrowX, arrowY - 2, 2, style.getTextColor());
-            Draw::line(arrowX, arrowY - 2, arrowX + 4, arrowY + 2, 2, style.getTextColor());
-        } else {
-            // Down arrow
-            Draw::line(arrowX - 4, arrowY - 2, arrowX, arrowY + 2, 2, style.getTextColor());
-            Draw::line(arrowX, arrowY + 2, arrowX + 4, arrowY - 2, 2, style.getTextColor());
-        }
+        Draw::polyline({{arrowX - 4, arrowY - tip}, {arrowX, arrowY + tip}, {arrowX + 4, arrowY - tip}},
+                       2, style.getTextColor());
     }
     
     void DropdownWidget::renderText(const std::string& text, int x, int y, uint32_t color) {
         const auto& style = config_.getStyle();
         
-        // Calculate available width for text (excluding padding and arrow space)
-        int availableWidth = config_.getWidth() - style.getPadding() * 2 - 30; // 30 for arrow
-        
-        // Clip text if it's too long
-        std::string displayText = text;
-        if (calculateTextWidth(text) > availableWidth) {
-            // Find the maximum number of characters that fit
-            std::string clippedText;
-            for (size_t i = 0; i < text.length(); ++i) {
-                std::string candidate = text.substr(0, i + 1);
-                if (calculateTextWidth(candidate) > availableWidth) {
-                    break;
-                }
-                clippedText = candidate;
-            }
-            displayText = clippedText;
-        }
-        
         if (style.getFontType() == FontType::TTF && Font::hasTTFFont()) {
-            Font::renderTTF(globalCanvas, displayText, x, y, style.getFontSize(), color);
+            Font::renderTTF(globalCanvas, text, x, y, style.getFontSize(), color);
         } else {
-            DrawText::drawText(displayText.c_str(), x, y, style.getFontSize(), color);
+            DrawText::drawText(text.c_str(), x, y, style.getFontSize(), color);
         }
     }
     
+    int DropdownWidget::getTextAreaWidth() const {
+        // Padding on both sides plus 30px reserved for the arrow
+        return config_.getWidth() - config_.getStyle().getPadding() * 2 - 30;
+    }
+    
     bool DropdownWidget::isPointInMainButton(int x, int y) const {
         return x >= x_ && x < x_ + config_.getWidth() &&
                y >= y_ && y < y_ + config_.getHeight();
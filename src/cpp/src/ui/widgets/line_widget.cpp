@@ -17,18 +17,22 @@ namespace Fern {
     
     void LineWidget::setStart(Point start) {
         start_ = start;
+        invalidate();
     }
     
     void LineWidget::setEnd(Point end) {
         end_ = end;
+        invalidate();
     }
     
     void LineWidget::setThickness(int thickness) {
         thickness_ = thickness;
+        invalidate();
     }
     
     void LineWidget::setColor(uint32_t color) {
         color_ = color;
+        invalidate();
     }
     
     std::shared_ptr<LineWidget> Line(Point start, Point end, int thickness, uint32_t color, bool addToManager) {
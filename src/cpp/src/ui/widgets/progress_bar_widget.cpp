@@ -57,6 +57,7 @@ namespace Fern {
         clampValue();
         
         if (oldValue != currentValue_) {
+            invalidate();
             onValueChanged.emit(currentValue_);
             
             // Check if we reached 100%
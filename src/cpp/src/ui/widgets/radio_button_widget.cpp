@@ -26,13 +26,16 @@ namespace Fern {
         int radioX = x_ + style.getRadius();
         int radioY = y_ + style.getRadius();
         
-        // Draw radio button background
+        // Draw radio button background, leaving room for the border ring around it
+        int borderWidth = style.getBorderWidth();
+        int bgRadius = borderWidth > 0 ? style.getRadius() - 1 : style.getRadius();
         uint32_t bgColor = isHovered_ ? style.getHoverColor() : style.getBackgroundColor();
-        Draw::circle(radioX, radioY, style.getRadius(), bgColor);
+        Draw::circle(radioX, radioY, bgRadius, bgColor);
         
         // Draw border
-        for (int i = 0; i < style.getBorderWidth(); ++i) {
-            Draw::circle(radioX, radioY, style.getRadius() + i, style.getBorderColor());
+        if (borderWidth > 0) {
+            Draw::ring(radioX, radioY, bgRadius, bgRadius + borderWidth, 0.0f, 360.0f,
+                       style.getBorderColor());
         }
         
         // Draw selection indicator
@@ -66,6 +69,7 @@ namespace Fern {
     void RadioButtonWidget::setSelected(bool selected) {
         if (selected_ != selected) {
             selected_ = selected;
+            invalidate();
             onSelectionChanged.emit(selected_);
             
             if (selected_) {
@@ -86,6 +90,7 @@ namespace Fern {
         int textWidth = calculateTextWidth();
         int totalWidth = config_.getStyle().getRadius() * 2 + config_.getStyle().getSpacing() + textWidth;
         resize(totalWidth, height_);
+        invalidate();
     }
     
     void RadioButtonWidget::renderText() {
@@ -20,14 +20,17 @@ namespace Fern {
         const int trackY = y_ + (config_.getHeight() - trackHeight) / 2;
         
         // Clear the entire widget area first to prevent overpainting
-        // Include extra space for thumb at extremes
-        int thumbRadius = style.getThumbRadius();
-        int clearX = x_ - thumbRadius;
-        int clearWidth = config_.getWidth() + thumbRadius * 2;
-        if (style.getShowValue()) {
-            clearWidth += 60; // Extra space for value text
+        // Include extra space for thumb at extremes. Without a background
+        // color the caller is expected to have cleared the frame already.
+        if (style.hasBackground()) {
+            int thumbRadius = style.getThumbRadius();
+            int clearX = x_ - thumbRadius;
+            int clearWidth = config_.getWidth() + thumbRadius * 2;
+            if (style.getShowValue()) {
+                clearWidth += 60; // Extra space for value text
+            }
+            Draw::rect(clearX, y_, clearWidth, config_.getHeight(), style.getBackgroundColor());
         }
-        Draw::rect(clearX, y_, clearWidth, config_.getHeight(), 0x00000000); // Transparent background
         
         // Draw track background
         Draw::rect(x_, trackY, config_.getWidth(), trackHeight, style.getTrackColor());
@@ -104,6 +107,7 @@ namespace Fern {
         clampValue();
         
         if (oldValue != currentValue_) {
+            invalidate();
             onValueChanged.emit(currentValue_);
         }
     }
@@ -0,0 +1,506 @@
+#include "../../../include/fern/ui/widgets/text_area_widget.hpp"
+#include "../../../include/fern/core/canvas.hpp"
+#include "../../../include/fern/core/input.hpp"
+#include "../../../include/fern/core/widget_manager.hpp"
+#include "../../../include/fern/graphics/primitives.hpp"
+#include "../../../include/fern/text/font.hpp"
+#include "../../../include/fern/font/font.hpp"
+#include <algorithm>
+
+extern Fern::Canvas* globalCanvas;
+
+namespace Fern {
+    TextAreaWidget::TextAreaWidget(const TextAreaConfig& config)
+        : config_(config) {
+        addCapabilities(WidgetCapability::Focusable);
+        setPosition(config.getX(), config.getY());
+        resize(config.getWidth(), config.getHeight());
+        updateFont();
+    }
+
+    void TextAreaWidget::updateFont() {
+        // Same lookup as TextInputWidget: only after a font was loaded or
+        // the default changed, and laid-out lines are only dropped if that
+        // changed which font is used
+        auto& manager = TTFFontManager::getInstance();
+        if (fontsGeneration_ == manager.getGeneration()) return;
+        bool resolved = fontsGeneration_ != 0;
+        fontsGeneration_ = manager.getGeneration();
+
+        const auto& style = config_.getStyle();
+        TTFFontRenderer* font = nullptr;
+        if (style.getFontType() == FontType::TTF) {
+            const std::string& name = style.getTTFFontName();
+            font = name.empty() ? nullptr : manager.getFont(name);
+            if (!font) font = manager.getDefaultFont();
+        }
+        if (resolved && font == font_) return;
+        font_ = font;
+
+        if (font) {
+            advance_ = [font](uint32_t codepoint) { return font->getAdvanceUnits(codepoint); };
+            kerning_ = [font](uint32_t left, uint32_t right) { return font->getKerningUnits(left, right); };
+        } else {
+            int scale = style.getFontSize();
+            advance_ = [scale](uint32_t codepoint) { return DrawText::charWidth(codepoint, scale); };
+            kerning_ = nullptr;
+        }
+        invalidateLayouts();
+    }
+
+    int TextAreaWidget::toPixels(int32_t units) const {
+        return font_ ? font_->toPixels(units, config_.getStyle().getFontSize()) : units;
+    }
+
+    int TextAreaWidget::lineHeight() const {
+        int size = config_.getStyle().getFontSize();
+        // Bitmap cells are 8 pixels tall; two more rows separate the lines
+        int height = font_ ? font_->getLineHeight(size) : size * 10;
+        return std::max(1, height);
+    }
+
+    int TextAreaWidget::visibleLineCount() const {
+        // Partly visible lines count; they are drawn clipped
+        int height = lineHeight();
+        return std::max(1, (textArea().height + height - 1) / height);
+    }
+
+    Rect TextAreaWidget::textArea() const {
+        const auto& style = config_.getStyle();
+        int inset = style.getPadding() + style.getBorderWidth();
+        return Rect(x_ + inset, y_ + inset, config_.getWidth() - 2 * inset, config_.getHeight() - 2 * inset);
+    }
+
+    void TextAreaWidget::syncWindow() {
+        size_t lineCount = document_.lineCount();
+        firstLine_ = std::min(firstLine_, lineCount - 1);
+        size_t count = std::min(static_cast<size_t>(visibleLineCount()), lineCount - firstLine_);
+
+        // Scrolling keeps the layouts of lines that stay on screen; only
+        // the lines scrolled into view are measured again
+        if (firstLine_ > windowLine_) {
+            size_t shift = std::min(firstLine_ - windowLine_, lines_.size());
+            lines_.erase(lines_.begin(), lines_.begin() + shift);
+        } else if (firstLine_ < windowLine_) {
+            size_t shift = std::min(windowLine_ - firstLine_, count);
+            lines_.insert(lines_.begin(), shift, LineLayout());
+        }
+        lines_.resize(count);
+        windowLine_ = firstLine_;
+
+        if (detachedLine_ >= windowLine_ && detachedLine_ < windowLine_ + count) {
+            detachedLine_ = SIZE_MAX;
+        }
+    }
+
+    TextAreaWidget::LineLayout& TextAreaWidget::layoutOf(size_t line) {
+        LineLayout* layout;
+        if (line >= windowLine_ && line - windowLine_ < lines_.size()) {
+            layout = &lines_[line - windowLine_];
+        } else {
+            if (detachedLine_ != line) {
+                detachedLine_ = line;
+                detached_.measured = false;
+            }
+            layout = &detached_;
+        }
+        if (!layout->measured) measureLine(line, *layout);
+        return *layout;
+    }
+
+    void TextAreaWidget::measureLine(size_t line, LineLayout& layout) {
+        layout.text = document_.line(line);
+        layout.widths.setMetrics(advance_, kerning_);
+        layout.widths.assign(layout.text);
+        layout.measured = true;
+        layout.runDirty = true;
+    }
+
+    void TextAreaWidget::linesChanged(size_t line, size_t removed, size_t added) {
+        // The text of `line` changed, the `removed` lines after it are gone
+        // and `added` new lines follow it. Lines further down only moved.
+        if (detachedLine_ != SIZE_MAX && detachedLine_ >= line) {
+            detachedLine_ = SIZE_MAX;
+        }
+        if (line < windowLine_) {
+            // Everything on screen may have moved; edits above the view
+            // are rare (the cursor is kept on screen), so start over
+            lines_.clear();
+            windowLine_ = firstLine_;
+            return;
+        }
+
+        size_t index = line - windowLine_;
+        if (index >= lines_.size()) return;
+        lines_[index].measured = false;
+
+        auto next = lines_.begin() + index + 1;
+        size_t erased = std::min(removed, static_cast<size_t>(lines_.end() - next));
+        next = lines_.erase(next, next + erased);
+        lines_.insert(next, added, LineLayout());
+        // syncWindow() trims the window and measures lines that moved up
+    }
+
+    void TextAreaWidget::invalidateLayouts() {
+        for (LineLayout& layout : lines_) {
+            layout.measured = false;
+        }
+        detachedLine_ = SIZE_MAX;
+    }
+
+    void TextAreaWidget::render() {
+        updateFont();
+        syncWindow();
+
+        renderBackground();
+        renderBorder();
+
+        Rect area = textArea();
+        if (area.isEmpty()) return;
+        globalCanvas->pushClip(area.x, area.y, area.width, area.height);
+        renderLines(area);
+        if (isFocused_) {
+            renderCursor(area);
+        }
+        globalCanvas->popClip();
+    }
+
+    void TextAreaWidget::renderBackground() {
+        Draw::rect(x_, y_, config_.getWidth(), config_.getHeight(), config_.getStyle().getBackgroundColor());
+    }
+
+    void TextAreaWidget::renderBorder() {
+        const auto& style = config_.getStyle();
+        uint32_t borderColor = isFocused_ ? style.getFocusBorderColor() : style.getBorderColor();
+
+        if (style.getBorderWidth() > 0) {
+            Draw::roundedRectBorder(x_, y_, config_.getWidth(), config_.getHeight(), 0,
+                                  style.getBorderWidth(), borderColor);
+        }
+    }
+
+    void TextAreaWidget::renderLines(const Rect& area) {
+        const auto& style = config_.getStyle();
+        int size = style.getFontSize();
+        int height = lineHeight();
+        int ascent = font_ ? font_->getAscent(size) : 0;
+        int x = area.x - scrollX_;
+
+        for (size_t i = 0; i < lines_.size(); i++) {
+            int y = area.y + static_cast<int>(i) * height;
+            LineLayout& layout = lines_[i];
+            if (!layout.measured) measureLine(windowLine_ + i, layout);
+            if (layout.text.empty()) continue;
+
+            if (font_) {
+                // Glyph runs survive frames; a line is laid out again only
+                // after an edit or when the glyph cache dropped its glyphs
+                if (layout.runDirty || !font_->isCurrent(layout.run)) {
+                    font_->layoutText(layout.text, size, layout.run);
+                    layout.runDirty = false;
+                }
+                font_->drawRun(globalCanvas, layout.run, x, y + ascent, style.getTextColor());
+            } else {
+                DrawText::drawText(layout.text.c_str(), x, y, size, style.getTextColor());
+            }
+        }
+    }
+
+    void TextAreaWidget::renderCursor(const Rect& area) {
+        if (cursorLine_ < windowLine_ || cursorLine_ - windowLine_ >= lines_.size()) return;
+
+        const auto& style = config_.getStyle();
+        int size = style.getFontSize();
+        int cursorHeight = font_ ? font_->getTextHeight(size) : size * 8;
+        int cursorX = area.x - scrollX_ + toPixels(layoutOf(cursorLine_).widths.offset(cursorColumn_));
+        int cursorY = area.y + static_cast<int>(cursorLine_ - windowLine_) * lineHeight();
+        Draw::rect(cursorX, cursorY, 2, cursorHeight, style.getCursorColor());
+    }
+
+    bool TextAreaWidget::handleInput(const InputState& input) {
+        bool wasHandled = false;
+        updateFont();
+
+        if (input.mouseClicked) {
+            bool clickedInside = isPointInWidget(input.mouseX, input.mouseY);
+            setFocus(clickedInside);
+            if (clickedInside) {
+                // Put the cursor at the character boundary nearest the click
+                syncWindow();
+                Rect area = textArea();
+                size_t row = static_cast<size_t>(std::max(0, input.mouseY - area.y) / lineHeight());
+                cursorLine_ = std::min(firstLine_ + row, document_.lineCount() - 1);
+                cursorColumn_ = columnAt(layoutOf(cursorLine_), input.mouseX - area.x + scrollX_);
+                preferredX_ = -1;
+                scrollToCursor();
+                wasHandled = true;
+            }
+        }
+
+        if (isFocused_) {
+            handleKeyInput(input);
+            if (input.hasTextInput && !input.textInput.empty()) {
+                insertText(input.textInput);
+            }
+            wasHandled = true;
+        }
+
+        return wasHandled;
+    }
+
+    void TextAreaWidget::handleKeyInput(const InputState& input) {
+        if (input.isKeyJustPressed(KeyCode::ArrowLeft)) {
+            moveHorizontally(-1);
+        }
+        if (input.isKeyJustPressed(KeyCode::ArrowRight)) {
+            moveHorizontally(1);
+        }
+        if (input.isKeyJustPressed(KeyCode::ArrowUp)) {
+            moveVertically(-1);
+        }
+        if (input.isKeyJustPressed(KeyCode::ArrowDown)) {
+            moveVertically(1);
+        }
+        if (input.isKeyJustPressed(KeyCode::Backspace)) {
+            deleteCharacter(false);
+        }
+        if (input.isKeyJustPressed(KeyCode::Delete)) {
+            deleteCharacter(true);
+        }
+        if (input.isKeyJustPressed(KeyCode::Enter)) {
+            insertText("\n");
+        }
+        if (input.isKeyJustPressed(KeyCode::Tab)) {
+            insertText("    ");
+        }
+        if (input.isKeyJustPressed(KeyCode::Escape)) {
+            setFocus(false);
+        }
+    }
+
+    void TextAreaWidget::insertText(const std::string& text) {
+        if (config_.isReadOnly() || text.empty()) return;
+
+        LineLayout& layout = layoutOf(cursorLine_);
+        size_t begin = layout.widths.byteOffset(cursorColumn_);
+        document_.insert(document_.lineStart(cursorLine_) + begin, text);
+
+        size_t added = static_cast<size_t>(std::count(text.begin(), text.end(), '\n'));
+        if (added == 0) {
+            // Typing within a line: update its widths in place and lay out
+            // only its glyph run again
+            layout.text.insert(begin, text);
+            cursorColumn_ += layout.widths.insert(cursorColumn_, text);
+            layout.runDirty = true;
+        } else {
+            // The cursor ends up in front of what followed it, on the last
+            // of the new lines
+            size_t tail = layout.widths.size() - cursorColumn_;
+            linesChanged(cursorLine_, 0, added);
+            cursorLine_ += added;
+            cursorColumn_ = layoutOf(cursorLine_).widths.size() - tail;
+        }
+
+        preferredX_ = -1;
+        scrollToCursor();
+        onTextChanged.emit();
+    }
+
+    void TextAreaWidget::deleteCharacter(bool forward) {
+        if (config_.isReadOnly()) return;
+
+        LineLayout& layout = layoutOf(cursorLine_);
+        size_t start = document_.lineStart(cursorLine_);
+        if (!forward && cursorColumn_ == 0) {
+            // Join with the line above
+            if (cursorLine_ == 0) return;
+            size_t column = layoutOf(cursorLine_ - 1).widths.size();
+            document_.erase(start - 1, 1);
+            cursorLine_--;
+            linesChanged(cursorLine_, 1, 0);
+            cursorColumn_ = column;
+        } else if (forward && cursorColumn_ == layout.widths.size()) {
+            // Join with the line below
+            if (cursorLine_ + 1 >= document_.lineCount()) return;
+            document_.erase(start + layout.text.size(), 1);
+            linesChanged(cursorLine_, 1, 0);
+        } else {
+            if (!forward) cursorColumn_--;
+            size_t begin = layout.widths.byteOffset(cursorColumn_);
+            size_t count = layout.widths.byteOffset(cursorColumn_ + 1) - begin;
+            document_.erase(start + begin, count);
+            layout.text.erase(begin, count);
+            layout.widths.erase(cursorColumn_, 1);
+            layout.runDirty = true;
+        }
+
+        preferredX_ = -1;
+        scrollToCursor();
+        onTextChanged.emit();
+    }
+
+    void TextAreaWidget::moveHorizontally(int direction) {
+        if (direction < 0) {
+            if (cursorColumn_ > 0) {
+                cursorColumn_--;
+            } else if (cursorLine_ > 0) {
+                cursorLine_--;
+                cursorColumn_ = layoutOf(cursorLine_).widths.size();
+            }
+        } else if (direction > 0) {
+            if (cursorColumn_ < layoutOf(cursorLine_).widths.size()) {
+                cursorColumn_++;
+            } else if (cursorLine_ + 1 < document_.lineCount()) {
+                cursorLine_++;
+                cursorColumn_ = 0;
+            }
+        }
+        preferredX_ = -1;
+        scrollToCursor();
+    }
+
+    void TextAreaWidget::moveVertically(int direction) {
+        size_t line = cursorLine_;
+        if (direction < 0 && line > 0) {
+            line--;
+        } else if (direction > 0 && line + 1 < document_.lineCount()) {
+            line++;
+        }
+        if (line == cursorLine_) return;
+
+        // Keep heading for the column the move started from, across short
+        // lines in between
+        if (preferredX_ < 0) {
+            preferredX_ = toPixels(layoutOf(cursorLine_).widths.offset(cursorColumn_));
+        }
+        cursorLine_ = line;
+        cursorColumn_ = columnAt(layoutOf(line), preferredX_);
+        scrollToCursor();
+    }
+
+    size_t TextAreaWidget::columnAt(const LineLayout& layout, int x) const {
+        const MeasuredText& widths = layout.widths;
+        size_t length = widths.size();
+        size_t past = widths.partitionPoint(0, length, [&](size_t i) {
+            return toPixels(widths.offset(i)) >= x;
+        });
+        if (past > length) return length;
+        if (past > 0 && x - toPixels(widths.offset(past - 1)) < toPixels(widths.offset(past)) - x) {
+            return past - 1;
+        }
+        return past;
+    }
+
+    void TextAreaWidget::scrollToCursor() {
+        Rect area = textArea();
+
+        // Vertically, keep the cursor's line wholly on screen
+        size_t fullLines = static_cast<size_t>(std::max(1, area.height / lineHeight()));
+        if (cursorLine_ < firstLine_) {
+            firstLine_ = cursorLine_;
+        } else if (cursorLine_ >= firstLine_ + fullLines) {
+            firstLine_ = cursorLine_ + 1 - fullLines;
+        }
+        syncWindow();
+
+        // Horizontally, jump by a third of the width so that typing at the
+        // edge does not scroll on every character
+        int cursorX = toPixels(layoutOf(cursorLine_).widths.offset(cursorColumn_));
+        int width = std::max(1, area.width - 2);
+        if (cursorX < scrollX_) {
+            scrollX_ = std::max(0, cursorX - width / 3);
+        } else if (cursorX > scrollX_ + width) {
+            scrollX_ = cursorX - width * 2 / 3;
+        }
+    }
+
+    void TextAreaWidget::setCursor(size_t line, size_t column) {
+        // Lines are laid out below, perhaps before the next frame looks the
+        // font up again
+        updateFont();
+        cursorLine_ = std::min(line, document_.lineCount() - 1);
+        cursorColumn_ = std::min(column, layoutOf(cursorLine_).widths.size());
+        preferredX_ = -1;
+        scrollToCursor();
+        invalidate();
+    }
+
+    void TextAreaWidget::scrollToLine(size_t line) {
+        firstLine_ = std::min(line, document_.lineCount() - 1);
+        invalidate();
+    }
+
+    bool TextAreaWidget::isPointInWidget(int x, int y) const {
+        return x >= x_ && x < x_ + config_.getWidth() &&
+               y >= y_ && y < y_ + config_.getHeight();
+    }
+
+    void TextAreaWidget::setText(const std::string& text) {
+        document_.assign(text);
+        lines_.clear();
+        detachedLine_ = SIZE_MAX;
+        firstLine_ = windowLine_ = 0;
+        cursorLine_ = cursorColumn_ = 0;
+        preferredX_ = -1;
+        scrollX_ = 0;
+        invalidate();
+        onTextChanged.emit();
+    }
+
+    void TextAreaWidget::appendText(const std::string& text) {
+        if (text.empty()) return;
+
+        // Only the last line and the lines after it change; a cursor
+        // anywhere before the end keeps its place
+        size_t last = document_.lineCount() - 1;
+        document_.insert(document_.size(), text);
+        linesChanged(last, 0, static_cast<size_t>(std::count(text.begin(), text.end(), '\n')));
+        invalidate();
+        onTextChanged.emit();
+    }
+
+    void TextAreaWidget::setFocus(bool focused) {
+        if (isFocused_ != focused) {
+            isFocused_ = focused;
+            onFocusChanged.emit(focused);
+        }
+    }
+
+    // Widget interface methods
+    int TextAreaWidget::getWidth() const {
+        return config_.getWidth();
+    }
+
+    int TextAreaWidget::getHeight() const {
+        return config_.getHeight();
+    }
+
+    void TextAreaWidget::setPosition(int x, int y) {
+        x_ = x;
+        y_ = y;
+        config_.setPosition(x, y);
+    }
+
+    int TextAreaWidget::getX() const {
+        return config_.getX();
+    }
+
+    int TextAreaWidget::getY() const {
+        return config_.getY();
+    }
+
+    void TextAreaWidget::resize(int width, int height) {
+        config_.setSize(width, height);
+    }
+
+    // Helper functions
+    std::shared_ptr<TextAreaWidget> TextArea(const TextAreaConfig& config, bool addToManager) {
+        auto widget = std::make_shared<TextAreaWidget>(config);
+
+        if (addToManager) {
+            addWidget(widget);
+        }
+
+        return widget;
+    }
+}
@@ -18,8 +18,48 @@ namespace Fern {
     TextInputWidget::TextInputWidget(const TextInputConfig& config)
         : config_(config), text_(""), cursorPosition_(0), isFocused_(false), 
           showCursor_(true), cursorBlinkTimer_(0) {
+        addCapabilities(WidgetCapability::Focusable);
         setPosition(config.getX(), config.getY());
         resize(config.getWidth(), config.getHeight());
+        updateMetrics();
+    }
+    
+    void TextInputWidget::updateMetrics() {
+        // Fonts are only looked up again after one was loaded or the
+        // default changed; the text is only measured again if that changed
+        // which font is used
+        auto& manager = TTFFontManager::getInstance();
+        if (fontsGeneration_ == manager.getGeneration()) return;
+        bool measured = fontsGeneration_ != 0;
+        fontsGeneration_ = manager.getGeneration();
+        
+        const auto& style = config_.getStyle();
+        TTFFontRenderer* font = nullptr;
+        if (style.getFontType() == FontType::TTF) {
+            const std::string& name = style.getTTFFontName();
+            font = name.empty() ? nullptr : manager.getFont(name);
+            if (!font) font = manager.getDefaultFont();
+        }
+        if (measured && font == font_) return;
+        font_ = font;
+        
+        MeasuredText::AdvanceFunction advance;
+        MeasuredText::KerningFunction kerning;
+        if (font) {
+            advance = [font](uint32_t codepoint) { return font->getAdvanceUnits(codepoint); };
+            kerning = [font](uint32_t left, uint32_t right) { return font->getKerningUnits(left, right); };
+        } else {
+            int scale = style.getFontSize();
+            advance = [scale](uint32_t codepoint) { return DrawText::charWidth(codepoint, scale); };
+        }
+        model_.setMetrics(advance, kerning);
+        model_.assign(text_);
+        placeholderModel_.setMetrics(advance, kerning);
+        placeholderModel_.assign(config_.getPlaceholder());
+    }
+    
+    int TextInputWidget::toPixels(int32_t units) const {
+        return font_ ? font_->toPixels(units, config_.getStyle().getFontSize()) : units;
     }
     
     void TextInputWidget::render() {
@@ -44,60 +84,42 @@ namespace Fern {
         uint32_t borderColor = isFocused_ ? style.getFocusBorderColor() : style.getBorderColor();
         
         if (style.getBorderWidth() > 0) {
-            // Top border
-            Draw::rect(x_, y_, config_.getWidth(), style.getBorderWidth(), borderColor);
-            // Bottom border
-            Draw::rect(x_, y_ + config_.getHeight() - style.getBorderWidth(), 
-                      config_.getWidth(), style.getBorderWidth(), borderColor);
-            // Left border
-            Draw::rect(x_, y_, style.getBorderWidth(), config_.getHeight(), borderColor);
-            // Right border
-            Draw::rect(x_ + config_.getWidth() - style.getBorderWidth(), y_, 
-                      style.getBorderWidth(), config_.getHeight(), borderColor);
+            Draw::roundedRectBorder(x_, y_, config_.getWidth(), config_.getHeight(), 0,
+                                  style.getBorderWidth(), borderColor);
         }
     }
     
     void TextInputWidget::renderText() {
+        updateMetrics();
+        
         const auto& style = config_.getStyle();
-        std::string displayText = text_;
-        bool isPlaceholder = false;
+        int textX = x_ + style.getPadding() + style.getBorderWidth();
+        int textY = y_ + style.getPadding() + style.getBorderWidth();
         
-        // Show placeholder if empty and not focused
-        if (displayText.empty() && !isFocused_ && !config_.getPlaceholder().empty()) {
-            displayText = config_.getPlaceholder();
-            isPlaceholder = true;
+        // Calculate available width for text (excluding padding and borders)
+        int availableWidth = config_.getWidth() - 2 * (style.getPadding() + style.getBorderWidth());
+        
+        if (text_.empty()) {
+            // Show placeholder if empty and not focused, clipped to the field
+            if (isFocused_ || placeholderModel_.empty()) return;
+            const std::string& placeholder = config_.getPlaceholder();
+            size_t bytes = placeholderModel_.byteOffset(fittingLength(placeholderModel_, availableWidth));
+            drawString(placeholder.substr(0, bytes), textX, textY, 0xFF888888); // Gray for placeholder
+            return;
         }
         
-        if (!displayText.empty()) {
-            int textX = x_ + style.getPadding() + style.getBorderWidth();
-            int textY = y_ + style.getPadding() + style.getBorderWidth();
-            
-            // Calculate available width for text (excluding padding and borders)
-            int availableWidth = config_.getWidth() - 2 * (style.getPadding() + style.getBorderWidth());
-            
-            // For placeholder, just clip it
-            if (isPlaceholder) {
-                std::string clippedText = clipTextToWidth(displayText, availableWidth);
-                uint32_t textColor = 0x888888; // Gray for placeholder
-                
-                if (style.getFontType() == FontType::TTF && Font::hasTTFFont()) {
-                    Font::renderTTF(globalCanvas, clippedText, textX, textY, 
-                                   style.getFontSize(), textColor, style.getTTFFontName());
-                } else {
-                    DrawText::drawText(clippedText.c_str(), textX, textY, style.getFontSize(), textColor);
-                }
-            } else {
-                // For actual text, implement scrolling to show cursor
-                std::string visibleText = getVisibleText(displayText, availableWidth);
-                uint32_t textColor = style.getTextColor();
-                
-                if (style.getFontType() == FontType::TTF && Font::hasTTFFont()) {
-                    Font::renderTTF(globalCanvas, visibleText, textX, textY, 
-                                   style.getFontSize(), textColor, style.getTTFFontName());
-                } else {
-                    DrawText::drawText(visibleText.c_str(), textX, textY, style.getFontSize(), textColor);
-                }
-            }
+        // For actual text, scroll to keep the cursor visible
+        size_t first, last;
+        visibleRange(first, last);
+        size_t begin = model_.byteOffset(first);
+        drawString(text_.substr(begin, model_.byteOffset(last) - begin), textX, textY, style.getTextColor());
+    }
+    
+    void TextInputWidget::drawString(const std::string& text, int x, int y, uint32_t color) {
+        if (font_) {
+            font_->renderText(globalCanvas, text, x, y, config_.getStyle().getFontSize(), color);
+        } else {
+            DrawText::drawText(text.c_str(), x, y, config_.getStyle().getFontSize(), color);
         }
     }
     
@@ -123,6 +145,9 @@ namespace Fern {
     }
     
     bool TextInputWidget::handleInput(const InputState& input) {
+        // A font loaded under the same name since the last frame replaced
+        // the one model_ measures with
+        updateMetrics();
         bool wasHandled = false;
         
         // Check for mouse click to set focus
@@ -132,7 +157,7 @@ namespace Fern {
             if (clickedInside) {
                 // Set cursor position based on click location
                 // For now, just set to end of text
-                cursorPosition_ = text_.length();
+                cursorPosition_ = model_.size();
                 wasHandled = true;
             }
         }
@@ -183,7 +208,7 @@ namespace Fern {
                 cursorPosition_--;
             }
         } else if (direction > 0) {
-            if (cursorPosition_ < text_.length()) {
+            if (cursorPosition_ < model_.size()) {
                 cursorPosition_++;
             }
         }
@@ -191,88 +216,79 @@ namespace Fern {
     
     void TextInputWidget::insertText(const std::string& text) {
         if (text_.length() + text.length() <= config_.getMaxLength()) {
-            text_.insert(cursorPosition_, text);
-            cursorPosition_ += text.length();
+            text_.insert(model_.byteOffset(cursorPosition_), text);
+            cursorPosition_ += model_.insert(cursorPosition_, text);
             onTextChanged.emit(text_);
         }
     }
     
     void TextInputWidget::deleteCharacter(bool forward) {
-        if (forward) {
-            if (cursorPosition_ < text_.length()) {
-                text_.erase(cursorPosition_, 1);
-                onTextChanged.emit(text_);
-            }
-        } else {
-            if (cursorPosition_ > 0) {
-                cursorPosition_--;
-                text_.erase(cursorPosition_, 1);
-                onTextChanged.emit(text_);
-            }
+        if (!forward) {
+            if (cursorPosition_ == 0) return;
+            cursorPosition_--;
+        } else if (cursorPosition_ >= model_.size()) {
+            return;
         }
+        
+        size_t begin = model_.byteOffset(cursorPosition_);
+        text_.erase(begin, model_.byteOffset(cursorPosition_ + 1) - begin);
+        model_.erase(cursorPosition_, 1);
+        onTextChanged.emit(text_);
     }
     
-    int TextInputWidget::getTextWidth(const std::string& text) const {
+    void TextInputWidget::visibleRange(size_t& first, size_t& last) const {
+        // Every width below is a difference of two prefix sums, so each
+        // search step is O(1) and the whole search O(log n)
         const auto& style = config_.getStyle();
-        if (style.getFontType() == FontType::TTF && Font::hasTTFFont()) {
-            return Font::getTextWidth(text, style.getFontSize(), FontType::TTF);
-        } else {
-            // Bitmap font: calculate width correctly based on character types
-            int width = 0;
-            int scale = style.getFontSize();
-            
-            for (char c : text) {
-                if (c == ' ') {
-                    width += 4 * scale;  // Space is 4 pixels wide
-                } else if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9')) {
-                    width += 8 * scale;  // Regular characters are 8 pixels wide
-                } else {
-                    width += 4 * scale;  // Unsupported characters are 4 pixels wide
-                }
-            }
-            return width;
-        }
+        int availableWidth = config_.getWidth() - 2 * (style.getPadding() + style.getBorderWidth());
+        size_t length = model_.size();
+        size_t cursor = std::min(cursorPosition_, length);
+        
+        // If the full text fits, show it all
+        if (toPixels(model_.width()) <= availableWidth) {
+            first = 0;
+            last = length;
+            return;
+        }
+        
+        // If cursor is at the end (most common case when typing), show the
+        // longest stretch of text that ends at the cursor
+        if (cursor == length) {
+            first = std::min(length, model_.partitionPoint(0, length, [&](size_t i) {
+                return toPixels(model_.span(i, length)) <= availableWidth;
+            }));
+            last = length;
+            return;
+        }
+        
+        // For cursor in middle, put as much text before it as fits in half
+        // the field, then fill the rest after it
+        int halfWidth = availableWidth / 2;
+        first = model_.partitionPoint(0, cursor, [&](size_t i) {
+            return toPixels(model_.span(i, cursor)) <= halfWidth;
+        });
+        first = std::min(first, cursor);
+        size_t past = model_.partitionPoint(first, length, [&](size_t i) {
+            return toPixels(model_.span(first, i)) > availableWidth;
+        });
+        last = std::max(past ? past - 1 : 0, cursor);
+    }
+    
+    size_t TextInputWidget::fittingLength(const MeasuredText& text, int maxWidth) const {
+        size_t past = text.partitionPoint(0, text.size(), [&](size_t i) {
+            return toPixels(text.offset(i)) > maxWidth;
+        });
+        return past ? past - 1 : 0;
     }
     
     int TextInputWidget::getCursorX() const {
         const auto& style = config_.getStyle();
         int baseX = x_ + style.getPadding() + style.getBorderWidth();
         
-        if (cursorPosition_ == 0) {
-            return baseX;
-        }
-        
-        // Calculate available width for text
-        int availableWidth = config_.getWidth() - 2 * (style.getPadding() + style.getBorderWidth());
-        
-        // Get the visible text
-        std::string visibleText = getVisibleText(text_, availableWidth);
-        
-        // Find where the visible text starts in the original text
-        size_t visibleStart = 0;
-        if (getTextWidth(text_) > availableWidth) {
-            // Find the start position of visible text
-            for (size_t i = 0; i <= text_.length(); i++) {
-                std::string candidate = text_.substr(i);
-                if (getVisibleText(candidate, availableWidth) == visibleText) {
-                    visibleStart = i;
-                    break;
-                }
-            }
-        }
-        
-        // Calculate cursor position relative to visible text
-        if (cursorPosition_ < visibleStart) {
-            return baseX; // Cursor is before visible text, show at start
-        }
-        
-        size_t relativeCursorPos = cursorPosition_ - visibleStart;
-        if (relativeCursorPos > visibleText.length()) {
-            relativeCursorPos = visibleText.length();
-        }
-        
-        std::string textToCursor = visibleText.substr(0, relativeCursorPos);
-        return baseX + getTextWidth(textToCursor);
+        size_t first, last;
+        visibleRange(first, last);
+        size_t cursor = std::min(std::max(cursorPosition_, first), last);
+        return baseX + toPixels(model_.span(first, cursor));
     }
     
     void TextInputWidget::updateCursorBlink() {
@@ -292,8 +308,11 @@ namespace Fern {
     
     void TextInputWidget::setText(const std::string& text) {
         if (text.length() <= config_.getMaxLength()) {
+            updateMetrics();
             text_ = text;
-            cursorPosition_ = std::min(cursorPosition_, text_.length());
+            model_.assign(text_);
+            cursorPosition_ = std::min(cursorPosition_, model_.size());
+            invalidate();
             onTextChanged.emit(text_);
         }
     }
@@ -357,10 +376,10 @@ namespace Fern {
             return TextInputConfig(x, y, width, height)
                 .placeholder("Enter text...")
                 .style(TextInputStyle()
-                    .backgroundColor(0xFFFFFF)
-                    .borderColor(0x888888)
-                    .focusBorderColor(0x0066CC)
-                    .textColor(0x000000)
+                    .backgroundColor(0xFFFFFFFF)
+                    .borderColor(0xFF888888)
+                    .focusBorderColor(0xFF0066CC)
+                    .textColor(0xFF000000)
                     .fontSize(2)  // Good for bitmap font
                     .useBitmapFont());
         }
@@ -369,10 +388,10 @@ namespace Fern {
             return TextInputConfig(x, y, width, height)
                 .placeholder("Type here...")
                 .style(TextInputStyle()
-                    .backgroundColor(0xF8F9FA)  // Light gray
-                    .borderColor(0xDEE2E6)      // Light border
-                    .focusBorderColor(0x007BFF)  // Modern blue
-                    .textColor(0x212529)        // Dark gray text
+                    .backgroundColor(0xFFF8F9FA)  // Light gray
+                    .borderColor(0xFFDEE2E6)      // Light border
+                    .focusBorderColor(0xFF007BFF)  // Modern blue
+                    .textColor(0xFF212529)        // Dark gray text
                     .fontSize(2)
                     .borderWidth(2)
                     .padding(8)
@@ -383,137 +402,14 @@ namespace Fern {
             return TextInputConfig(x, y, width, height)
                 .placeholder("TTF Font Input...")
                 .style(TextInputStyle()
-                    .backgroundColor(0xFFFFFF)
-                    .borderColor(0x666666)
-                    .focusBorderColor(0x0066CC)
-                    .textColor(0x000000)
+                    .backgroundColor(0xFFFFFFFF)
+                    .borderColor(0xFF666666)
+                    .focusBorderColor(0xFF0066CC)
+                    .textColor(0xFF000000)
                     .fontSize(24)  // TTF needs larger sizes
                     .borderWidth(2)
                     .padding(8)
                     .useTTFFont(fontName));
         }
     }
-    
-    std::string TextInputWidget::clipTextToWidth(const std::string& text, int maxWidth) const {
-        if (text.empty()) return text;
-        
-        // If the full text fits, return it
-        if (getTextWidth(text) <= maxWidth) {
-            return text;
-        }
-        
-        // Find the maximum number of characters that fit
-        std::string result;
-        int currentWidth = 0;
-        const auto& style = config_.getStyle();
-        int scale = style.getFontSize();
-        
-        for (char c : text) {
-            int charWidth;
-            if (c == ' ') {
-                charWidth = 4 * scale;
-            } else if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9')) {
-                charWidth = 8 * scale;
-            } else {
-                charWidth = 4 * scale;
-            }
-            
-            if (currentWidth + charWidth > maxWidth) {
-                break;
-            }
-            
-            result += c;
-            currentWidth += charWidth;
-        }
-        
-        return result;
-    }
-    
-    std::string TextInputWidget::getVisibleText(const std::string& text, int availableWidth) const {
-        if (text.empty()) return text;
-        
-        // If the full text fits, return it
-        if (getTextWidth(text) <= availableWidth) {
-            return text;
-        }
-        
-        // Ensure cursor is always visible - calculate visible text based on cursor position
-        size_t startPos = 0;
-        size_t endPos = text.length();
-        
-        // If cursor is at the end (most common case when typing), show text ending at cursor
-        if (cursorPosition_ >= text.length()) {
-            // Start from the end and work backwards to find maximum visible text
-            while (startPos < text.length()) {
-                std::string candidate = text.substr(startPos);
-                if (getTextWidth(candidate) <= availableWidth) {
-                    break;
-                }
-                startPos++;
-            }
-            return text.substr(startPos);
-        }
-        
-        // For cursor in middle, try to center it in the visible area
-        size_t cursorPos = std::min(cursorPosition_, text.length());
-        
-        // Calculate ideal start position (cursor roughly in middle of visible area)
-        size_t idealStart = 0;
-        if (cursorPos > 0) {
-            // Estimate how many characters fit in half the available width
-            int halfWidth = availableWidth / 2;
-            size_t charCount = 0;
-            int currentWidth = 0;
-            
-            // Count characters from cursor backwards
-            for (size_t i = cursorPos; i > 0 && currentWidth < halfWidth; i--) {
-                char c = text[i - 1];
-                int charWidth = getCharWidth(c);
-                if (currentWidth + charWidth > halfWidth) break;
-                currentWidth += charWidth;
-                charCount++;
-            }
-            
-            idealStart = cursorPos - charCount;
-        }
-        
-        // Find the actual start position that fits
-        startPos = idealStart;
-        while (startPos < text.length()) {
-            // Try to include the cursor position
-            endPos = std::max(cursorPos + 1, startPos + 1);
-            
-            // Extend as much as possible
-            while (endPos < text.length()) {
-                std::string candidate = text.substr(startPos, endPos - startPos + 1);
-                if (getTextWidth(candidate) > availableWidth) {
-                    break;
-                }
-                endPos++;
-            }
-            
-            // Check if cursor is visible
-            if (startPos <= cursorPos && cursorPos <= endPos) {
-                break;
-            }
-            
-            startPos++;
-        }
-        
-        return text.substr(startPos, endPos - startPos);
-    }
-    
-    int TextInputWidget::getCharWidth(char c) const {
-        const auto& style = config_.getStyle();
-        int scale = style.getFontSize();
-        
-        if (c == ' ') {
-            return 4 * scale;
-        } else if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9')) {
-            return 8 * scale;
-        } else {
-            return 4 * scale;
-        }
-    }
-}
-
+}
\ No newline at end of file
@@ -55,21 +55,13 @@ namespace Fern {
     void TextWidget::renderShadow() {
         if (config_.getStyle().hasShadow()) {
             int offset = config_.getStyle().getShadowOffset();
-            switch (fontType_) {
-                case FontType::TTF:
-                    if (Font::hasTTFFont()) {
-                        Font::renderTTF(globalCanvas, text_, x_ + offset, y_ + offset, 
-                                       size_, config_.getStyle().getShadowColor());
-                    } else {
-                        DrawText::drawText(text_.c_str(), x_ + offset, y_ + offset, 
-                                         size_, config_.getStyle().getShadowColor());
-                    }
-                    break;
-                case FontType::Bitmap:
-                default:
-                    DrawText::drawText(text_.c_str(), x_ + offset, y_ + offset, 
-                                     size_, config_.getStyle().getShadowColor());
-                    break;
+            uint32_t shadowColor = config_.getStyle().getShadowColor();
+            TTFFontRenderer* font = fontType_ == FontType::TTF ? layout() : nullptr;
+            if (font) {
+                // Same run as the main text, just offset
+                font->drawRun(globalCanvas, run_, x_ + offset, y_ + offset, shadowColor);
+            } else {
+                DrawText::drawText(text_.c_str(), x_ + offset, y_ + offset, size_, shadowColor);
             }
         }
     }
@@ -87,29 +79,72 @@ namespace Fern {
     }
     
     void TextWidget::renderTTF() {
-        if (Font::hasTTFFont()) {
-            Font::renderTTF(globalCanvas, text_, x_, y_, size_, color_);
+        TTFFontRenderer* font = layout();
+        if (font) {
+            font->drawRun(globalCanvas, run_, x_, y_, color_);
         } else {
             renderBitmap();
         }
     }
     
+    TTFFontRenderer* TextWidget::resolveFont() {
+        auto& manager = TTFFontManager::getInstance();
+        const std::string& name = config_.getStyle().getTTFFontName();
+        TTFFontRenderer* font = name.empty() ? nullptr : manager.getFont(name);
+        return font ? font : manager.getDefaultFont();
+    }
+    
+    TTFFontRenderer* TextWidget::layout() {
+        // Fonts are only looked up again after one was loaded or the
+        // default changed, and the text only laid out again when something
+        // it depends on did
+        auto& manager = TTFFontManager::getInstance();
+        if (runFontsGeneration_ != manager.getGeneration()) {
+            TTFFontRenderer* font = resolveFont();
+            if (font != runFont_) runDirty_ = true;
+            runFont_ = font;
+            runFontsGeneration_ = manager.getGeneration();
+        }
+        if (!runFont_) return nullptr;
+        
+        if (runDirty_ || !runFont_->isCurrent(run_)) {
+            runFont_->layoutText(text_, size_, run_);
+            runDirty_ = false;
+        }
+        return runFont_;
+    }
+    
     void TextWidget::renderBitmap() {
         DrawText::drawText(text_.c_str(), x_, y_, size_, color_);
     }
     
     void TextWidget::setText(const std::string& text) {
+        if (text == text_) return;
         text_ = text;
+        runDirty_ = true;
         updateDimensions();
+        invalidate();
     }
     
     void TextWidget::setSize(int size) {
+        if (size == size_) return;
         size_ = size;
+        runDirty_ = true;
+        updateDimensions();
+        invalidate();
+    }
+    
+    void TextWidget::setFontType(FontType type) {
+        if (type == fontType_) return;
+        fontType_ = type;
+        runDirty_ = true;
         updateDimensions();
+        invalidate();
     }
     
     void TextWidget::setColor(uint32_t color) {
         color_ = color;
+        invalidate();
     }
     
     void TextWidget::setConfig(const TextConfig& config) {
@@ -118,6 +153,8 @@ namespace Fern {
         size_ = config.getStyle().getFontSize();
         color_ = config.getStyle().getColor();
         fontType_ = config.getStyle().getFontType();
+        runDirty_ = true;
+        runFontsGeneration_ = 0;  // The font name may have changed
         setPosition(config.getX(), config.getY());
         updateDimensions();
     }
@@ -125,10 +162,12 @@ namespace Fern {
     void TextWidget::updateDimensions() {
         int textWidth, textHeight;
         
-        // Calculate dimensions based on font type
-        if (fontType_ == FontType::TTF && Font::hasTTFFont()) {
-            textWidth = Font::getTextWidth(text_, size_, FontType::TTF);
-            textHeight = Font::getTextHeight(size_, FontType::TTF);
+        // Calculate dimensions based on font type; the TTF run measures
+        // the text as it lays it out
+        TTFFontRenderer* font = fontType_ == FontType::TTF ? layout() : nullptr;
+        if (font) {
+            textWidth = run_.width;
+            textHeight = font->getTextHeight(size_);
         } else {
             // Use bitmap font calculation that matches the actual drawing
             textWidth = 0;
@@ -142,7 +181,10 @@ namespace Fern {
             textHeight = 8 * size_;  // Bitmap font height is 8 * scale pixels
         }
         
+        if (textWidth == width_ && textHeight == height_) return;
         resize(textWidth, textHeight);
+        // Let the enclosing layout make room for the new size
+        if (getParent()) invalidateLayout();
     }
     
     // Modern factory function with configuration
@@ -0,0 +1,133 @@
+#include "../../../include/fern/ui/widgets/widget.hpp"
+#include <algorithm>
+#include <vector>
+
+namespace Fern {
+    namespace {
+        // Layout passes in progress. Invalidations made while one runs only
+        // set flags; the running pass or the next one picks them up.
+        int layoutDepth = 0;
+        
+        // Open beginLayoutBatch() calls, and the widgets whose layout they
+        // deferred. A widget is listed once, and unlists itself if it's
+        // destroyed before the batch ends.
+        int batchDepth = 0;
+        std::vector<Widget*> queuedLayouts;
+    }
+    
+    Widget::~Widget() {
+        if (layoutQueued_) {
+            queuedLayouts.erase(std::find(queuedLayouts.begin(), queuedLayouts.end(), this));
+        }
+    }
+    
+    Size Widget::measure(const Constraints& constraints) {
+        if (measureDirty_) {
+            measuredCount_ = 0;
+            measureDirty_ = false;
+        }
+        for (int i = 0; i < measuredCount_; i++) {
+            if (measuredFor_[i] == constraints) return measured_[i];
+        }
+        
+        Size size = onMeasure(constraints);
+        measuredFor_[1] = measuredFor_[0];
+        measured_[1] = measured_[0];
+        measuredFor_[0] = constraints;
+        measured_[0] = size;
+        measuredCount_ = std::min(measuredCount_ + 1, 2);
+        return size;
+    }
+    
+    void Widget::arrange(const Rect& bounds) {
+        if (!arrangeDirty_ && bounds.width == getWidth() && bounds.height == getHeight()) {
+            // Same size, same content: the subtree only moves
+            if (bounds.x != getX() || bounds.y != getY()) {
+                setPosition(bounds.x, bounds.y);
+            }
+            return;
+        }
+        
+        layoutDepth++;
+        onArrange(bounds);
+        layoutDepth--;
+        // Cleared afterwards, so that children resized by onArrange() can't
+        // send a second pass up through this widget
+        arrangeDirty_ = false;
+    }
+    
+    void Widget::onArrange(const Rect& bounds) {
+        if (bounds.x != getX() || bounds.y != getY()) {
+            setPosition(bounds.x, bounds.y);
+        }
+        if (bounds.width != getWidth() || bounds.height != getHeight()) {
+            resize(bounds.width, bounds.height);
+        }
+    }
+    
+    void Widget::invalidateLayout() {
+        // Flag the whole path to the top level: every layout on it has to
+        // measure this widget again, the ones beside it don't
+        for (Widget* widget = this; widget; widget = widget->parent_) {
+            widget->measureDirty_ = true;
+            widget->arrangeDirty_ = true;
+        }
+        
+        scheduleLayout();
+        requestRedraw();
+    }
+    
+    void Widget::scheduleLayout() {
+        if (layoutDepth > 0) return;
+        
+        Widget* root = this;
+        bool deferred = false;
+        for (Widget* widget = this; widget; widget = widget->parent_) {
+            deferred = deferred || widget->updateDepth_ > 0;
+            root = widget;
+        }
+        
+        if (batchDepth > 0) {
+            // Queued even when a beginUpdate() defers it too, since that
+            // update may end first
+            if (!root->layoutQueued_) {
+                root->layoutQueued_ = true;
+                queuedLayouts.push_back(root);
+            }
+        } else if (!deferred) {
+            root->layoutIfNeeded();
+        }
+    }
+    
+    void Widget::endUpdate() {
+        if (--updateDepth_ == 0 && needsLayout()) {
+            scheduleLayout();
+        }
+    }
+    
+    void Widget::beginLayoutBatch() {
+        batchDepth++;
+    }
+    
+    void Widget::endLayoutBatch() {
+        if (--batchDepth > 0) return;
+        
+        // A queued widget may have been added to a layout since; its new
+        // top-level widget is laid out instead
+        while (!queuedLayouts.empty()) {
+            Widget* widget = queuedLayouts.back();
+            queuedLayouts.pop_back();
+            widget->layoutQueued_ = false;
+            widget->scheduleLayout();
+        }
+    }
+    
+    void Widget::layoutIfNeeded() {
+        if (!needsLayout()) return;
+        
+        layoutDepth++;
+        Size size = measure(Constraints());
+        arrange(Rect(getX(), getY(), size.width, size.height));
+        layoutDepth--;
+    }
+}